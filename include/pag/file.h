@@ -2097,6 +2097,8 @@ class PAG_API Composition {
 
   friend class VectorComposition;
 
+  friend class StaticTimeRangesScope;
+
   RTTR_ENABLE()
 };
 
@@ -2123,6 +2125,8 @@ class PAG_API VectorComposition : public Composition {
   RTTR_ENABLE(Composition)
 };
 
+class DecodeStream;
+
 class PAG_API ImageBytes {
  public:
   ImageBytes();
@@ -2170,9 +2174,15 @@ class PAG_API ImageBytes {
 
  private:
   bool encrypted = false;
+  /**
+   * The owner of the file data decoded from a PAG file, fileBytes is an alias of it. The decoded
+   * images share the data through it instead of copying it.
+   */
+  std::shared_ptr<ByteData> sharedBytes = nullptr;
 
   friend class ImageBytesCache;
   friend class EncryptedCodec;
+  friend void ReadImageFileBytes(DecodeStream* stream, ImageBytes* imageBytes);
 };
 
 class PAG_API BitmapRect {
@@ -2541,6 +2551,14 @@ class PAG_API File {
  */
 int64_t PAG_API CalculateGraphicsMemory(std::shared_ptr<File> file);
 
+/**
+ * Calculate the memory cost by graphics of each frame of the file in bytes, the size of the
+ * returned vector equals to the frame duration of the file. The costs are measured at the original
+ * size of the file, scale them by the square of the display scale to estimate the cost on screen.
+ * Hosts can use it to decide how many files fit in the memory budget before creating players.
+ */
+std::vector<int64_t> PAG_API CalculateGraphicsMemoriesPerFrame(std::shared_ptr<File> file);
+
 class CodecContext;
 
 class PAG_API Codec {
@@ -495,6 +495,7 @@ class PAG_API PAGLayer : public Content {
   void setStartTimeInternal(int64_t time);
   int64_t currentTimeInternal() const;
   Frame currentFrameInternal() const;
+  bool getSkippedTime(int64_t* layerTime) const;
   bool setCurrentTimeInternal(int64_t time);
   bool frameVisible() const;
   void removeFromParentOrOwner();
@@ -504,6 +505,7 @@ class PAG_API PAGLayer : public Content {
   PAGLayer* getParentOrOwner() const;
   bool getTransform(Transform* transform);
   bool gotoTimeAndNotifyChanged(int64_t targetTime);
+  void invalidateRetainedCaches();
 
   friend class PAGComposition;
 
@@ -532,6 +534,8 @@ class PAG_API PAGLayer : public Content {
   friend class ContentVersion;
 
   friend class PAGDecoder;
+
+  friend class LayerTimeline;
 };
 
 class SolidLayer;
@@ -822,6 +826,8 @@ class PreComposeLayer;
 
 class VectorComposition;
 
+class LayerTimeline;
+
 class PAG_API PAGComposition : public PAGLayer {
  public:
   /**
@@ -957,6 +963,7 @@ class PAG_API PAGComposition : public PAGLayer {
       std::function<bool(PAGLayer* pagLayer)> filterFunc);
   float frameRateInternal() const override;
   bool gotoTime(int64_t layerTime) override;
+  virtual int64_t getChildTime(int64_t layerTime) const;
   Frame childFrameToLocal(Frame childFrame, float childFrameRate) const override;
   Frame localFrameToChild(Frame localFrame, float childFrameRate) const override;
   int widthInternal() const;
@@ -979,6 +986,8 @@ class PAG_API PAGComposition : public PAGLayer {
 
  private:
   VectorComposition* emptyComposition = nullptr;
+  // Created on the first gotoTime() call, indexes the visible ranges of the child layers.
+  LayerTimeline* timeline = nullptr;
 
   static void FindLayers(std::function<bool(PAGLayer* pagLayer)> filterFunc,
                          std::vector<std::shared_ptr<PAGLayer>>* result,
@@ -989,6 +998,7 @@ class PAG_API PAGComposition : public PAGLayer {
                                         std::vector<std::shared_ptr<PAGLayer>>* results);
   static bool GetChildLayerAtPoint(PAGLayer* childLayer, float x, float y,
                                    std::vector<std::shared_ptr<PAGLayer>>* results);
+  static void MeasureChildHitBounds(tgfx::Rect* bounds, PAGLayer* childLayer);
 
   bool getLayersUnderPointInternal(float x, float y,
                                    std::vector<std::shared_ptr<PAGLayer>>* results);
@@ -997,6 +1007,9 @@ class PAG_API PAGComposition : public PAGLayer {
   void doSetLayerIndex(std::shared_ptr<PAGLayer> pagLayer, int index);
   bool doContains(PAGLayer* layer) const;
   void updateDurationAndFrameRate();
+  void invalidateTimeline();
+  int64_t childTimeOffset() const;
+  bool getSkippedChildTime(const PAGLayer* child, int64_t* childTime) const;
 
   friend class PAGLayer;
 
@@ -1129,6 +1142,7 @@ class PAG_API PAGFile : public PAGComposition {
 
  protected:
   bool gotoTime(int64_t layerTime) override;
+  int64_t getChildTime(int64_t layerTime) const override;
   Frame childFrameToLocal(Frame childFrame, float childFrameRate) const override;
   Frame localFrameToChild(Frame localFrame, float childFrameRate) const override;
   std::vector<std::shared_ptr<PAGLayer>> getLayersByEditableIndexInternal(int editableIndex,
@@ -1265,6 +1279,7 @@ class PAG_API PAGSurface {
   bool draw(RenderCache* cache, std::shared_ptr<Graphic> graphic, BackendSemaphore* signalSemaphore,
             bool autoClear = true);
   bool prepare(RenderCache* cache, std::shared_ptr<Graphic> graphic);
+  int warmUp(RenderCache* cache);
   bool hitTest(RenderCache* cache, std::shared_ptr<Graphic> graphic, float x, float y);
   tgfx::Context* lockContext();
   void unlockContext();
@@ -1347,6 +1362,19 @@ class PAG_API PAGPlayer {
    */
   void setUseDiskCache(bool value);
 
+  /**
+   * If set to true, PAGPlayer adapts the quality of expensive effects, such as motion blur and
+   * glow, to the rendering performance. The effects are rendered at a lower quality when frames
+   * miss the deadline of the composition's frame rate, and are restored to full quality once
+   * there is enough headroom. The default value is false.
+   */
+  bool adaptiveQuality();
+
+  /**
+   * Set the value of adaptiveQuality property.
+   */
+  void setAdaptiveQuality(bool value);
+
   /**
    * This value defines the scale factor for internal graphics caches, ranges from 0.0 to 1.0. The
    * scale factors less than 1.0 may result in blurred output, but it can reduce the usage of
@@ -1444,6 +1472,15 @@ class PAG_API PAGPlayer {
    */
   void prepare();
 
+  /**
+   * Compiles the GPU programs of all effects, layer styles and motion blurs in the current
+   * composition ahead of time, so that none of them is compiled lazily by a frame in the middle of
+   * the animation. It is usually called once before the playback starts. Returns the number of
+   * filters that are ready to use, or -1 if the player has no surface or the GPU context is
+   * unavailable.
+   */
+  int warmUp();
+
   /**
    * Inserts a GPU semaphore that the current GPU-backed API must wait on before executing any more
    * commands on the GPU for this player. It is usually called before PAGPlayer.flush(). PAG will
@@ -1648,6 +1685,9 @@ class PAG_API PAGDecoder {
                                                     float maxFrameRate);
   static std::vector<TimeRange> GetStaticTimeRange(std::shared_ptr<PAGComposition> composition,
                                                    int numFrames);
+  static std::vector<TimeRange> GetFileStaticTimeRange(PAGComposition* pagFile, int numFrames);
+  static std::vector<TimeRange> ScanStaticTimeRange(PAGComposition* composition, int numFrames);
+  static bool HasExcludedLayers(PAGComposition* composition);
 
   PAGDecoder(std::shared_ptr<PAGComposition> composition, int width, int height, int numFrames,
              float frameRate, float maxFrameRate);
@@ -1662,6 +1702,7 @@ class PAG_API PAGDecoder {
   void setCacheKeyGeneratorFun(
       std::function<std::string(PAGDecoder*, std::shared_ptr<PAGComposition>)> fun);
   friend class DiskSequenceReader;
+  friend class FrameProvider;
 };
 
 /**
@@ -1698,6 +1739,24 @@ class PAG_API PAGVideoDecoder {
    */
   static void SetMaxHardwareDecoderCount(int count);
 
+  /**
+   * Set the maximum number of idle video decoders that PAG keeps for reuse. Video decoders that are
+   * no longer used are kept in a pool and handed over to new video sequences with the same video
+   * format, which saves the initialization time of the decoders. The default value is 4. Set it to
+   * 0 to disable the pool.
+   */
+  static void SetMaxIdleDecoderCount(int count);
+
+  /**
+   * Set the maximum memory in bytes that each video sequence can use to keep the frames decoded
+   * while seeking backwards, such as playing in reverse or scrubbing the timeline. The frames
+   * between the previous keyframe and the target frame are kept, so that seeking backwards within
+   * the same GOP no longer decodes the whole GOP again. Only software decoders support it. Lowering
+   * the value releases the cached frames above the new limit immediately. The default value is 0,
+   * which disables the cache.
+   */
+  static void SetMaxReverseCacheSize(size_t bytes);
+
   /**
    * Register a software decoder factory to PAG, which can be used to create video decoders for
    * decoding video sequences from a pag file, if hardware decoders are not available.
@@ -19,6 +19,7 @@
 #include "pag/file.h"
 #include <algorithm>
 #include <unordered_map>
+#include "base/utils/StaticTimeRangesScope.h"
 
 namespace pag {
 
@@ -45,6 +46,7 @@ File::File(std::vector<Composition*> compositionList, std::vector<pag::ImageByte
       _numLayers++;
     }
   }
+  StaticTimeRangesScope::Apply(compositions);
 }
 
 File::~File() {
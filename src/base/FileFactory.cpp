@@ -17,41 +17,116 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <array>
 #include <unordered_map>
+#include "base/utils/HashUtil.h"
 #include "pag/file.h"
 
 namespace pag {
 
-static std::mutex globalLocker = {};
-static std::unordered_map<std::string, std::weak_ptr<File>> weakFileMap =
-    std::unordered_map<std::string, std::weak_ptr<File>>();
+static constexpr size_t NumFileShards = 16;
 
-static std::shared_ptr<File> FindFileByPath(const std::string& filePath) {
-  std::lock_guard<std::mutex> autoLock(globalLocker);
-  if (filePath.empty()) {
+struct FileEntry {
+  std::weak_ptr<File> file;
+  // The length and a second hash of the bytes the file was decoded from. Only checked for the files
+  // loaded without a path, whose keys are content hashes that different bytes can share.
+  bool checkContent = false;
+  size_t length = 0;
+  uint64_t checksum = 0;
+
+  bool matches(size_t contentLength, uint64_t contentChecksum) const {
+    return !checkContent || (length == contentLength && checksum == contentChecksum);
+  }
+};
+
+/**
+ * The live files are spread across several shards by the hash of their keys, so that concurrent
+ * loaders of different files do not contend for one global lock.
+ */
+struct FileShard {
+  std::mutex locker = {};
+  std::unordered_map<std::string, FileEntry> fileMap = {};
+};
+
+static std::array<FileShard, NumFileShards> fileShards = {};
+
+static FileShard& GetFileShard(const std::string& fileKey) {
+  return fileShards[std::hash<std::string>()(fileKey) % NumFileShards];
+}
+
+static std::string MakeFileKey(uint64_t hash, size_t length, const std::string& filePath) {
+  if (!filePath.empty()) {
+    return filePath;
+  }
+  // Files loaded from memory have no path, use the hash of their contents instead, so that the
+  // identical bytes are decoded only once.
+  if (length == 0) {
+    return "";
+  }
+  return "bytes://" + std::to_string(hash) + "_" + std::to_string(length);
+}
+
+static void RemoveExpiredFile(const std::string& fileKey) {
+  auto& shard = GetFileShard(fileKey);
+  std::lock_guard<std::mutex> autoLock(shard.locker);
+  auto result = shard.fileMap.find(fileKey);
+  // The entry may have been taken over by a newer file with the same key in the meantime.
+  if (result != shard.fileMap.end() && result->second.file.expired()) {
+    shard.fileMap.erase(result);
+  }
+}
+
+static std::shared_ptr<File> FindFileByKey(const std::string& fileKey, size_t length,
+                                           uint64_t checksum) {
+  if (fileKey.empty()) {
+    return nullptr;
+  }
+  auto& shard = GetFileShard(fileKey);
+  // Declared before the lock, so that the last reference to a file is released after unlocking,
+  // whose deleter locks the shard again.
+  std::shared_ptr<File> file = nullptr;
+  std::lock_guard<std::mutex> autoLock(shard.locker);
+  auto result = shard.fileMap.find(fileKey);
+  if (result == shard.fileMap.end()) {
     return nullptr;
   }
-  auto result = weakFileMap.find(filePath);
-  if (result != weakFileMap.end()) {
-    auto& weak = result->second;
-    auto file = weak.lock();
-    if (file) {
-      return file;
-    }
-    weakFileMap.erase(result);
-    if (weakFileMap.size() > 50) {  // do cleaning.
-      std::vector<std::string> needRemoveList = {};
-      for (auto& item : weakFileMap) {
-        if (item.second.expired()) {
-          needRemoveList.push_back(item.first);
-        }
-      }
-      for (auto& item : needRemoveList) {
-        weakFileMap.erase(item);
-      }
-    }
+  file = result->second.file.lock();
+  // The same hash with different bytes is a miss, never hand out the file of other contents.
+  return file && result->second.matches(length, checksum) ? file : nullptr;
+}
+
+/**
+ * Stores the decoded file unless another thread has finished decoding the same key in the
+ * meantime, in which case the file already cached is returned, so that concurrent loaders always
+ * share one instance. A file whose bytes collide with the cached ones under the same key is
+ * returned as is without being cached. The entry of a cached file is removed as soon as the file
+ * is released.
+ */
+static std::shared_ptr<File> AddFile(const std::string& fileKey, std::shared_ptr<File> file,
+                                     size_t length, uint64_t checksum, bool checkContent) {
+  if (fileKey.empty()) {
+    return file;
+  }
+  auto& shard = GetFileShard(fileKey);
+  std::shared_ptr<File> cachedFile = nullptr;
+  std::lock_guard<std::mutex> autoLock(shard.locker);
+  auto& entry = shard.fileMap[fileKey];
+  cachedFile = entry.file.lock();
+  if (cachedFile) {
+    return entry.matches(length, checksum) ? cachedFile : file;
   }
-  return nullptr;
+  auto holder = std::move(file);
+  // The deleter runs once the last reference handed out is released, it removes the entry first
+  // and then releases the decoded file.
+  file = std::shared_ptr<File>(holder.get(), [fileKey, holder](File*) mutable {
+    RemoveExpiredFile(fileKey);
+    holder = nullptr;
+  });
+  entry.file = file;
+  entry.checkContent = checkContent;
+  entry.length = length;
+  entry.checksum = checksum;
+  return file;
 }
 
 std::shared_ptr<File> File::Load(const std::string& filePath, const std::string& password) {
@@ -64,17 +139,24 @@ std::shared_ptr<File> File::Load(const std::string& filePath, const std::string&
 
 std::shared_ptr<File> File::Load(const void* bytes, size_t length, const std::string& filePath,
                                  const std::string&) {
-  auto file = FindFileByPath(filePath);
+  auto contentLength = bytes != nullptr ? length : 0;
+  // Only the files loaded without a path are keyed by the hash of their contents.
+  uint64_t hash = 0;
+  uint64_t checksum = 0;
+  if (filePath.empty() && contentLength > 0) {
+    hash = Hash64(bytes, contentLength);
+    checksum = Checksum64(bytes, contentLength);
+  }
+  auto fileKey = MakeFileKey(hash, contentLength, filePath);
+  auto file = FindFileByKey(fileKey, contentLength, checksum);
   if (file != nullptr) {
     return file;
   }
   file = Codec::Decode(bytes, static_cast<uint32_t>(length), filePath);
-  if (file != nullptr) {
-    std::lock_guard<std::mutex> autoLock(globalLocker);
-    std::weak_ptr<File> weak = file;
-    weakFileMap.insert(std::make_pair(filePath, std::move(weak)));
+  if (file == nullptr) {
+    return nullptr;
   }
-  return file;
+  return AddFile(fileKey, file, contentLength, checksum, filePath.empty());
 }
 
 }  // namespace pag
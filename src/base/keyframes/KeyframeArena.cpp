@@ -0,0 +1,105 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "KeyframeArena.h"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace pag {
+static constexpr size_t BlockSize = 16 * 1024;
+// Every allocation is prefixed with a header that records the arena it comes from, the header
+// size keeps the returned pointer aligned the same way as malloc() does.
+static constexpr size_t HeaderSize = alignof(std::max_align_t);
+
+static thread_local KeyframeArena* currentArena = nullptr;
+
+static size_t AlignSize(size_t size) {
+  return (size + HeaderSize - 1) / HeaderSize * HeaderSize;
+}
+
+KeyframeArena::~KeyframeArena() {
+  for (auto& block : blocks) {
+    free(block);
+  }
+}
+
+void* KeyframeArena::allocate(size_t size) {
+  if (size > remaining) {
+    auto blockSize = size > BlockSize ? size : BlockSize;
+    auto block = static_cast<uint8_t*>(malloc(blockSize));
+    if (block == nullptr) {
+      return nullptr;
+    }
+    blocks.push_back(block);
+    cursor = block;
+    remaining = blockSize;
+  }
+  auto result = cursor;
+  cursor += size;
+  remaining -= size;
+  refCount++;
+  return result;
+}
+
+void KeyframeArena::unref() {
+  if (--refCount == 0) {
+    delete this;
+  }
+}
+
+KeyframeArenaScope::KeyframeArenaScope() : arena(new KeyframeArena()), lastArena(currentArena) {
+  currentArena = arena;
+}
+
+KeyframeArenaScope::~KeyframeArenaScope() {
+  currentArena = lastArena;
+  arena->unref();
+}
+
+void* KeyframeArena::Allocate(size_t size) {
+  auto totalSize = HeaderSize + AlignSize(size);
+  void* memory = nullptr;
+  if (currentArena != nullptr) {
+    memory = currentArena->allocate(totalSize);
+  }
+  auto arena = memory != nullptr ? currentArena : nullptr;
+  if (memory == nullptr) {
+    memory = malloc(totalSize);
+    if (memory == nullptr) {
+      throw std::bad_alloc();
+    }
+  }
+  *static_cast<KeyframeArena**>(memory) = arena;
+  return static_cast<uint8_t*>(memory) + HeaderSize;
+}
+
+void KeyframeArena::Deallocate(void* pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+  auto memory = static_cast<uint8_t*>(pointer) - HeaderSize;
+  auto arena = *reinterpret_cast<KeyframeArena**>(memory);
+  if (arena != nullptr) {
+    // The memory of arena keyframes is released together with the arena.
+    arena->unref();
+  } else {
+    free(memory);
+  }
+}
+}  // namespace pag
@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "pag/file.h"
+
+namespace pag {
+/**
+ * KeyframeArena hands out the memory of the keyframes decoded from one File in large blocks,
+ * instead of issuing a heap allocation for each of them. Keyframes are by far the most numerous
+ * objects in a decoded File, keeping them together improves the locality of the property
+ * evaluations and turns the teardown of a File into freeing a handful of blocks. The destructors
+ * of the keyframes still run as usual, the arena deletes itself after the last keyframe allocated
+ * from it and the scope that created it are both released.
+ */
+class KeyframeArena {
+ public:
+  /**
+   * Allocates the memory of a keyframe from the arena of the current scope, or from the heap if
+   * there is no scope on the current thread.
+   */
+  static void* Allocate(size_t size);
+
+  /**
+   * Releases the memory returned by Allocate().
+   */
+  static void Deallocate(void* pointer);
+
+  void* allocate(size_t size);
+
+  void unref();
+
+ private:
+  std::vector<uint8_t*> blocks = {};
+  uint8_t* cursor = nullptr;
+  size_t remaining = 0;
+  // One reference is held by the creating scope, the others by the allocated keyframes.
+  std::atomic_int refCount = {1};
+
+  KeyframeArena() = default;
+
+  ~KeyframeArena();
+
+  friend class KeyframeArenaScope;
+};
+
+/**
+ * Creates a KeyframeArena and routes the keyframes created on the current thread into it for as
+ * long as the scope is alive.
+ */
+class KeyframeArenaScope {
+ public:
+  KeyframeArenaScope();
+
+  ~KeyframeArenaScope();
+
+ private:
+  KeyframeArena* arena = nullptr;
+  KeyframeArena* lastArena = nullptr;
+};
+
+/**
+ * The keyframe types created by the codec, whose memory comes from the KeyframeArena. The public
+ * Keyframe class keeps the default allocation, and the virtual destructor routes the deletion of
+ * an ArenaKeyframe back to the arena.
+ */
+template <typename KeyframeType>
+class ArenaKeyframe : public KeyframeType {
+ public:
+  static void* operator new(size_t size) {
+    return KeyframeArena::Allocate(size);
+  }
+
+  static void operator delete(void* pointer) {
+    KeyframeArena::Deallocate(pointer);
+  }
+};
+}  // namespace pag
@@ -16,19 +16,43 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
-#include "DevicePool.h"
-#include <thread>
-#include <unordered_map>
+#include "HashUtil.h"
+#include <cstring>
 
 namespace pag {
-thread_local std::shared_ptr<tgfx::GLDevice> cachedDevice = nullptr;
-
-std::shared_ptr<tgfx::GLDevice> DevicePool::Make() {
-  auto device = cachedDevice;
-  if (device == nullptr) {
-    device = tgfx::GLDevice::Make();
-    cachedDevice = device;
+uint64_t Hash64(const void* bytes, size_t length, uint64_t seed) {
+  static constexpr uint64_t M = 0xc6a4a7935bd1e995ULL;
+  static constexpr int R = 47;
+  auto data = static_cast<const uint8_t*>(bytes);
+  uint64_t hash = seed ^ (length * M);
+  auto end = data + (length / 8) * 8;
+  while (data != end) {
+    uint64_t k = 0;
+    memcpy(&k, data, 8);
+    data += 8;
+    k *= M;
+    k ^= k >> R;
+    k *= M;
+    hash ^= k;
+    hash *= M;
+  }
+  auto remaining = length & 7;
+  if (remaining > 0) {
+    uint64_t k = 0;
+    for (size_t i = 0; i < remaining; i++) {
+      k |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    hash ^= k;
+    hash *= M;
   }
-  return device;
+  hash ^= hash >> R;
+  hash *= M;
+  hash ^= hash >> R;
+  return hash;
+}
+
+uint64_t Checksum64(const void* bytes, size_t length) {
+  static constexpr uint64_t ChecksumSeed = 0x9e3779b97f4a7c15ULL;
+  return Hash64(bytes, length, ChecksumSeed);
 }
 }  // namespace pag
@@ -18,11 +18,18 @@
 
 #pragma once
 
-#include "tgfx/gpu/opengl/GLDevice.h"
+#include <cstddef>
+#include <cstdint>
 
 namespace pag {
-class DevicePool {
- public:
-  static std::shared_ptr<tgfx::GLDevice> Make();
-};
+/**
+ * Computes a fast non-cryptographic 64-bit hash (MurmurHash64A) of the specified bytes.
+ */
+uint64_t Hash64(const void* bytes, size_t length, uint64_t seed = 0);
+
+/**
+ * Computes a second 64-bit hash of the specified bytes with a different seed from Hash64(). It is
+ * used together with Hash64() and the length to tell apart different bytes sharing one hash key.
+ */
+uint64_t Checksum64(const void* bytes, size_t length);
 }  // namespace pag
@@ -0,0 +1,70 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "StaticTimeRangesScope.h"
+
+namespace pag {
+static thread_local StaticTimeRangesScope* currentScope = nullptr;
+
+StaticTimeRangesScope::StaticTimeRangesScope(TimeRangesProvider provider)
+    : provider(std::move(provider)), lastScope(currentScope) {
+  currentScope = this;
+}
+
+StaticTimeRangesScope::~StaticTimeRangesScope() {
+  currentScope = lastScope;
+}
+
+static bool CheckTimeRanges(const std::vector<std::vector<TimeRange>>& timeRanges,
+                            const std::vector<Composition*>& compositions) {
+  if (timeRanges.size() != compositions.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < compositions.size(); i++) {
+    auto duration = compositions[i]->duration;
+    for (auto& range : timeRanges[i]) {
+      if (range.start < 0 || range.start > range.end || range.end >= duration) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void StaticTimeRangesScope::Apply(const std::vector<Composition*>& compositions) {
+  auto scope = currentScope;
+  if (scope == nullptr || scope->_decoded) {
+    return;
+  }
+  // Only the first File constructed in the scope is the one the time ranges were recorded from.
+  scope->_decoded = true;
+  if (scope->provider == nullptr) {
+    return;
+  }
+  auto timeRanges = scope->provider();
+  scope->provider = nullptr;
+  if (timeRanges.empty() || !CheckTimeRanges(timeRanges, compositions)) {
+    return;
+  }
+  for (size_t i = 0; i < compositions.size(); i++) {
+    compositions[i]->staticTimeRanges = std::move(timeRanges[i]);
+    compositions[i]->staticTimeRangeUpdated = true;
+  }
+  scope->_restored = true;
+}
+}  // namespace pag
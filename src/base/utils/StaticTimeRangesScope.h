@@ -0,0 +1,66 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "pag/file.h"
+
+namespace pag {
+using TimeRangesProvider = std::function<std::vector<std::vector<TimeRange>>()>;
+
+/**
+ * Hands the static time ranges restored from a previous analysis over to the next File constructed
+ * on the current thread, so that the codec skips computing them again. The provider is only called
+ * once that File is constructed, so nothing is read if the file is found in the cache instead. The
+ * ranges are ignored if they do not fit the compositions of that File.
+ */
+class StaticTimeRangesScope {
+ public:
+  explicit StaticTimeRangesScope(TimeRangesProvider provider);
+
+  ~StaticTimeRangesScope();
+
+  /**
+   * Returns true if a File has been constructed in the scope, which means the provider is called.
+   */
+  bool decoded() const {
+    return _decoded;
+  }
+
+  /**
+   * Returns true if the time ranges have been applied to the compositions of a File.
+   */
+  bool restored() const {
+    return _restored;
+  }
+
+  /**
+   * Applies the time ranges of the current scope to the specified compositions, and detaches them
+   * from the scope. Does nothing if there is no scope on the current thread.
+   */
+  static void Apply(const std::vector<Composition*>& compositions);
+
+ private:
+  TimeRangesProvider provider = nullptr;
+  StaticTimeRangesScope* lastScope = nullptr;
+  bool _decoded = false;
+  bool _restored = false;
+};
+}  // namespace pag
@@ -63,4 +63,61 @@ void WriteAttributeFlag(EncodeStream* stream, const AttributeFlag& flag,
   }
   stream->writeBitBoolean(flag.hasSpatial);
 }
-}  // namespace pag
\ No newline at end of file
+
+uint8_t MaxAttributeFlagBits(const AttributeBase* config) {
+  switch (config->attributeType) {
+    case AttributeType::FixedValue:
+      return 0;
+    case AttributeType::Value:
+    case AttributeType::BitFlag:
+    case AttributeType::Custom:
+      return 1;
+    case AttributeType::SpatialProperty:
+      return 3;
+    default:
+      return 2;
+  }
+}
+
+uint32_t BeginAttributeFlags(EncodeStream* stream, uint32_t maxFlagBits) {
+  stream->alignWithBytes();
+  auto position = stream->position();
+  auto reservedBytes = BitsToBytes(maxFlagBits);
+  for (size_t i = 0; i < reservedBytes; i++) {
+    stream->writeUint8(0);
+  }
+  return position;
+}
+
+void EndAttributeFlags(EncodeStream* stream, uint32_t flagPosition, uint32_t maxFlagBits,
+                       EncodeStream* flagBytes) {
+  stream->alignWithBytes();
+  flagBytes->alignWithBytes();
+  auto reservedBytes = static_cast<uint32_t>(BitsToBytes(maxFlagBits));
+  auto flagLength = flagBytes->length();
+  stream->setBytes(flagPosition, flagBytes);
+  if (flagLength < reservedBytes) {
+    // 预留的是最大可能的长度，多出来的字节需要移除，保证与先写入标记再写入内容的结果一致。
+    stream->removeBytes(flagPosition + flagLength, reservedBytes - flagLength);
+  }
+}
+
+void WriteBlockContent(EncodeStream* stream, BlockConfig* tagConfig) {
+  uint32_t maxFlagBits = 0;
+  for (auto& config : tagConfig->configs) {
+    maxFlagBits += MaxAttributeFlagBits(config);
+  }
+  auto flagPosition = BeginAttributeFlags(stream, maxFlagBits);
+  EncodeStream flagBytes(stream->context);
+  int index = 0;
+  for (auto& config : tagConfig->configs) {
+    auto target = tagConfig->targets[index];
+    config->writeAttribute(&flagBytes, stream, target);
+    index++;
+  }
+  // Actually the alignWithBytes() in EndAttributeFlags() has no effect on the flags,
+  // it is just for reminding us that we need to call
+  // alignWithBytes() when start reading this block.
+  EndAttributeFlags(stream, flagPosition, maxFlagBits, &flagBytes);
+}
+}  // namespace pag
@@ -20,6 +20,7 @@
 
 #include "DataTypes.h"
 #include "base/Keyframes.h"
+#include "base/keyframes/KeyframeArena.h"
 
 namespace pag {
 enum class AttributeType {
@@ -130,11 +131,11 @@ std::vector<Keyframe<T>*> ReadKeyframes(DecodeStream* stream, const AttributeCon
     Keyframe<T>* keyframe;
     if (config.attributeType == AttributeType::DiscreteProperty) {
       // There is no need to read any bits here.
-      keyframe = new Keyframe<T>();
+      keyframe = new ArenaKeyframe<Keyframe<T>>();
     } else {
       auto interpolationType = static_cast<Enum>(stream->readUBits(2));
       if (interpolationType == KeyframeInterpolationType::Hold) {
-        keyframe = new Keyframe<T>();
+        keyframe = new ArenaKeyframe<Keyframe<T>>();
       } else {
         keyframe = config.newKeyframe(flag);
         keyframe->interpolationType = interpolationType;
@@ -330,6 +331,30 @@ bool ReadBlock(DecodeStream* stream, T* parameter,
 void WriteAttributeFlag(EncodeStream* stream, const AttributeFlag& flag,
                         const AttributeBase* config);
 
+/**
+ * Returns the maximum number of bits WriteAttributeFlag() may write for the config.
+ */
+uint8_t MaxAttributeFlagBits(const AttributeBase* config);
+
+/**
+ * Reserves enough bytes for maxFlagBits bits of attribute flags at the current position, and
+ * returns the position of the reserved bytes. The attribute contents can then be written into the
+ * same stream directly, while the flags are collected in a separate small stream.
+ */
+uint32_t BeginAttributeFlags(EncodeStream* stream, uint32_t maxFlagBits);
+
+/**
+ * Copies the collected flags into the bytes reserved by BeginAttributeFlags() and removes the
+ * reserved bytes that are not used.
+ */
+void EndAttributeFlags(EncodeStream* stream, uint32_t flagPosition, uint32_t maxFlagBits,
+                       EncodeStream* flagBytes);
+
+/**
+ * Writes the attribute flags of the block followed by the attribute contents into the stream.
+ */
+void WriteBlockContent(EncodeStream* stream, BlockConfig* tagConfig);
+
 template <typename T>
 AttributeFlag WriteValue(EncodeStream* stream, const AttributeConfig<T>& config, const T& value) {
   AttributeFlag flag = {};
@@ -471,21 +496,10 @@ void WriteAttribute(EncodeStream* flagBytes, EncodeStream* stream, void* target,
 template <class T>
 void WriteTagBlock(EncodeStream* stream, T* parameter,
                    std::unique_ptr<BlockConfig> (*ConfigMaker)(T*)) {
-  EncodeStream flagBytes(stream->context);
-  EncodeStream bytes(stream->context);
   auto tagConfig = ConfigMaker(parameter);
-  int index = 0;
-  for (auto& config : tagConfig->configs) {
-    auto target = tagConfig->targets[index];
-    config->writeAttribute(&flagBytes, &bytes, target);
-    index++;
-  }
-  // Actually the alignWithBytes() here has no effect,
-  // it is just for reminding us that we need to call
-  // alignWithBytes() when start reading this block.
-  flagBytes.alignWithBytes();
-  flagBytes.writeBytes(&bytes);
-  WriteTagHeader(stream, &flagBytes, tagConfig->tagCode);
+  auto headerPosition = BeginTagHeader(stream);
+  WriteBlockContent(stream, tagConfig.get());
+  EndTagHeader(stream, headerPosition, tagConfig->tagCode);
 }
 
 template <class T>
@@ -494,18 +508,7 @@ void WriteBlock(EncodeStream* stream, T* parameter,
   // Must call alignWithBytes() here in case
   // we have already written some bit values in stream.
   stream->alignWithBytes();
-  EncodeStream contentBytes(stream->context);
   auto tagConfig = ConfigMaker(parameter);
-  int index = 0;
-  for (auto& config : tagConfig->configs) {
-    auto target = tagConfig->targets[index];
-    config->writeAttribute(stream, &contentBytes, target);
-    index++;
-  }
-  // Actually the alignWithBytes() here has no effect,
-  // it is just for reminding us that we need to call
-  // alignWithBytes() when start reading this block.
-  stream->alignWithBytes();
-  stream->writeBytes(&contentBytes);
+  WriteBlockContent(stream, tagConfig.get());
 }
 }  // namespace pag
@@ -39,7 +39,7 @@ class AttributeConfigBase : public AttributeBase {
   }
 
   virtual Keyframe<T>* newKeyframe(const AttributeFlag&) const {
-    return new K<T>();
+    return new ArenaKeyframe<K<T>>();
   }
 
   void readAttribute(DecodeStream* stream, const AttributeFlag& flag, void* target) const override {
@@ -270,13 +270,13 @@ class AttributeConfig<Point> : public AttributeConfigBase<Point> {
   Keyframe<Point>* newKeyframe(const AttributeFlag& flag) const override {
     switch (attributeType) {
       case AttributeType::MultiDimensionProperty:
-        return new MultiDimensionPointKeyframe();
+        return new ArenaKeyframe<MultiDimensionPointKeyframe>();
       case AttributeType::SpatialProperty:
         if (flag.hasSpatial) {
-          return new SpatialPointKeyframe();
+          return new ArenaKeyframe<SpatialPointKeyframe>();
         }
       default:
-        return new SingleEaseKeyframe<Point>();
+        return new ArenaKeyframe<SingleEaseKeyframe<Point>>();
     }
   }
 };
@@ -320,13 +320,13 @@ class AttributeConfig<Point3D> : public AttributeConfigBase<Point3D> {
   Keyframe<Point3D>* newKeyframe(const AttributeFlag& flag) const override {
     switch (attributeType) {
       case AttributeType::MultiDimensionProperty:
-        return new MultiDimensionPoint3DKeyframe();
+        return new ArenaKeyframe<MultiDimensionPoint3DKeyframe>();
       case AttributeType::SpatialProperty:
         if (flag.hasSpatial) {
-          return new SpatialPoint3DKeyframe();
+          return new ArenaKeyframe<SpatialPoint3DKeyframe>();
         }
       default:
-        return new SingleEaseKeyframe<Point3D>();
+        return new ArenaKeyframe<SingleEaseKeyframe<Point3D>>();
     }
   }
 };
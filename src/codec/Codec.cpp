@@ -19,6 +19,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include "CompressionAlgorithm.h"
+#include "base/keyframes/KeyframeArena.h"
 #include "base/utils/USE.h"
 #include "base/utils/Verify.h"
 #include "codec/Version.h"
@@ -209,6 +210,7 @@ DecodeStream ReadBodyBytes(DecodeStream* stream) {
 
 std::shared_ptr<File> Codec::Decode(const void* bytes, uint32_t byteLength,
                                     const std::string& filePath) {
+  KeyframeArenaScope arenaScope;
   CodecContext context = {};
   DecodeStream stream(&context, reinterpret_cast<const uint8_t*>(bytes), byteLength);
   auto bodyBytes = ReadBodyBytes(&stream);
@@ -241,17 +243,18 @@ std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file) {
 std::unique_ptr<ByteData> Codec::Encode(std::shared_ptr<File> file,
                                         std::shared_ptr<PerformanceData> performanceData) {
   CodecContext context = {};
-  EncodeStream bodyBytes(&context);
-  WriteTagsOfFile(&bodyBytes, file.get(), performanceData.get());
-
   EncodeStream fileBytes(&context);
   fileBytes.writeInt8('P');
   fileBytes.writeInt8('A');
   fileBytes.writeInt8('G');
   fileBytes.writeUint8(Version);
-  fileBytes.writeUint32(bodyBytes.length());
+  auto bodyLengthPosition = fileBytes.position();
+  fileBytes.writeUint32(0);
   fileBytes.writeInt8(CompressionAlgorithm::UNCOMPRESSED);
-  fileBytes.writeBytes(&bodyBytes);
+  auto bodyPosition = fileBytes.position();
+  // 标签直接写入文件流，写完后再回填 body 的长度。
+  WriteTagsOfFile(&fileBytes, file.get(), performanceData.get());
+  fileBytes.setUint32(bodyLengthPosition, fileBytes.length() - bodyPosition);
   return fileBytes.release();
 }
 
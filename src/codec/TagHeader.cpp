@@ -35,29 +35,38 @@ TagHeader ReadTagHeader(DecodeStream* stream) {
   return header;
 }
 
-void WriteTypeAndLength(EncodeStream* stream, TagCode code, uint32_t length) {
-  uint16_t typeAndLength = static_cast<uint16_t>(code) << 6;
-  if (length < 63) {
-    typeAndLength = typeAndLength | static_cast<uint8_t>(length);
-    stream->writeUint16(typeAndLength);
-  } else {
-    typeAndLength = typeAndLength | static_cast<uint8_t>(63);
-    stream->writeUint16(typeAndLength);
-    stream->writeUint32(length);
-  }
+void WriteEndTag(EncodeStream* stream) {
+  stream->writeUint16(0);
 }
 
-void WriteTagHeader(EncodeStream* stream, EncodeStream* tagBytes, TagCode code) {
-  WriteTypeAndLength(stream, code, tagBytes->length());
-  stream->writeBytes(tagBytes);
-}
+// 预留长格式的 header（2 字节类型 + 4 字节长度），标签内容直接写在后面，避免每层嵌套都拷贝一次。
+static constexpr uint32_t LongHeaderSize = 6;
 
-void WriteTagHeader(EncodeStream* stream, ByteData* tagBytes, TagCode code) {
-  WriteTypeAndLength(stream, code, static_cast<uint32_t>(tagBytes->length()));
-  stream->writeBytes(tagBytes->data(), static_cast<uint32_t>(tagBytes->length()));
+uint32_t BeginTagHeader(EncodeStream* stream) {
+  stream->alignWithBytes();
+  auto position = stream->position();
+  stream->writeUint16(0);
+  stream->writeUint32(0);
+  return position;
 }
 
-void WriteEndTag(EncodeStream* stream) {
-  stream->writeUint16(0);
+void EndTagHeader(EncodeStream* stream, uint32_t headerPosition, TagCode code) {
+  stream->alignWithBytes();
+  auto contentPosition = headerPosition + LongHeaderSize;
+  if (stream->length() < contentPosition) {
+    // header 都没能完整写入（例如扩容失败），直接移除，不能在流里留下全零的 End 标签。
+    stream->removeBytes(headerPosition, static_cast<uint32_t>(stream->length() - headerPosition));
+    return;
+  }
+  auto length = stream->length() - contentPosition;
+  uint16_t typeAndLength = static_cast<uint16_t>(code) << 6;
+  if (length < 63) {
+    // 长度小于 63 时使用短格式的 header，长度直接存在类型的低 6 位里。
+    stream->setUint16(headerPosition, typeAndLength | static_cast<uint8_t>(length));
+    stream->removeBytes(headerPosition + 2, LongHeaderSize - 2);
+  } else {
+    stream->setUint16(headerPosition, typeAndLength | static_cast<uint8_t>(63));
+    stream->setUint32(headerPosition + 2, length);
+  }
 }
 }  // namespace pag
@@ -49,16 +49,23 @@ void ReadTags(DecodeStream* stream, T parameter, void (*reader)(DecodeStream*, T
   }
 }
 
-void WriteTagHeader(EncodeStream* stream, EncodeStream* tagBytes, TagCode code);
+void WriteEndTag(EncodeStream* stream);
 
-void WriteTagHeader(EncodeStream* stream, ByteData* tagBytes, TagCode code);
+/**
+ * Reserves a tag header whose code and length are unknown yet, and returns the position of the
+ * header. The tag content can then be written into the same stream directly.
+ */
+uint32_t BeginTagHeader(EncodeStream* stream);
 
-void WriteEndTag(EncodeStream* stream);
+/**
+ * Fills in the tag header reserved by BeginTagHeader() once all the tag content is written.
+ */
+void EndTagHeader(EncodeStream* stream, uint32_t headerPosition, TagCode code);
 
 template <typename T>
 void WriteTag(EncodeStream* stream, T parameter, TagCode (*writer)(EncodeStream*, T)) {
-  EncodeStream bytes(stream->context);
-  auto code = writer(&bytes, parameter);
-  WriteTagHeader(stream, &bytes, code);
+  auto headerPosition = BeginTagHeader(stream);
+  auto code = writer(stream, parameter);
+  EndTagHeader(stream, headerPosition, code);
 }
 }  // namespace pag
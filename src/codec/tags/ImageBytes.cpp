@@ -21,10 +21,23 @@
 #include "codec/utils/WebpDecoder.h"
 
 namespace pag {
+void ReadImageFileBytes(DecodeStream* stream, ImageBytes* imageBytes) {
+  auto fileBytes = stream->readByteData();
+  if (fileBytes == nullptr) {
+    return;
+  }
+  // The alias keeps the shared data alive even if it is detached from the ImageBytes.
+  auto sharedBytes = std::shared_ptr<ByteData>(fileBytes.release());
+  auto releaseCallback = [sharedBytes](uint8_t*) {};
+  imageBytes->fileBytes =
+      ByteData::MakeAdopted(sharedBytes->data(), sharedBytes->length(), releaseCallback).release();
+  imageBytes->sharedBytes = sharedBytes;
+}
+
 ImageBytes* ReadImageBytes(DecodeStream* stream) {
   auto imageBytes = new ImageBytes();
   imageBytes->id = stream->readEncodedUint32();
-  imageBytes->fileBytes = stream->readByteData().release();
+  ReadImageFileBytes(stream, imageBytes);
   if (imageBytes->fileBytes == nullptr || imageBytes->fileBytes->length() == 0) {
     return imageBytes;
   }
@@ -22,6 +22,8 @@
 #include "codec/DataTypes.h"
 
 namespace pag {
+void ReadImageFileBytes(DecodeStream* stream, ImageBytes* imageBytes);
+
 ImageBytes* ReadImageBytes(DecodeStream* stream);
 
 TagCode WriteImageBytes(EncodeStream* stream, pag::ImageBytes* imageBytes);
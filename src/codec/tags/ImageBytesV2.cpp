@@ -24,7 +24,7 @@ namespace pag {
 ImageBytes* ReadImageBytesV2(DecodeStream* stream) {
   auto imageBytes = new ImageBytes();
   imageBytes->id = stream->readEncodedUint32();
-  imageBytes->fileBytes = stream->readByteData().release();
+  ReadImageFileBytes(stream, imageBytes);
   if (imageBytes->fileBytes == nullptr || imageBytes->fileBytes->length() == 0) {
     return imageBytes;
   }
@@ -23,7 +23,7 @@ namespace pag {
 ImageBytes* ReadImageBytesV3(DecodeStream* stream) {
   auto imageBytes = new ImageBytes();
   imageBytes->id = stream->readEncodedUint32();
-  imageBytes->fileBytes = stream->readByteData().release();
+  ReadImageFileBytes(stream, imageBytes);
   imageBytes->scaleFactor = stream->readFloat();
   imageBytes->width = stream->readEncodedInt32();
   imageBytes->height = stream->readEncodedInt32();
@@ -46,18 +46,19 @@ void WriteDashes(EncodeStream* stream, std::vector<Property<float>*>& dashes,
   if (dashes.empty()) {
     return;
   }
-  stream->alignWithBytes();
-  EncodeStream contentBytes(stream->context);
-
   auto dashLength = static_cast<uint32_t>(dashes.size());
   if (dashLength > 6) {
     dashLength = 6;
   }
-  stream->writeUBits(dashLength - 1, 3);
-  dashOffsetConfig.writeAttribute(stream, &contentBytes, &dashOffset);
+  auto maxFlagBits = 3 + MaxAttributeFlagBits(&dashOffsetConfig) +
+                     dashLength * MaxAttributeFlagBits(&dashConfig);
+  auto flagPosition = BeginAttributeFlags(stream, maxFlagBits);
+  EncodeStream flagBytes(stream->context);
+  flagBytes.writeUBits(dashLength - 1, 3);
+  dashOffsetConfig.writeAttribute(&flagBytes, stream, &dashOffset);
   for (uint32_t i = 0; i < dashLength; i++) {
-    dashConfig.writeAttribute(stream, &contentBytes, &(dashes[i]));
+    dashConfig.writeAttribute(&flagBytes, stream, &(dashes[i]));
   }
-  stream->writeBytes(&contentBytes);
+  EndAttributeFlags(stream, flagPosition, maxFlagBits, &flagBytes);
 }
 }  // namespace pag
@@ -45,6 +45,37 @@ void EncodeStream::setPosition(uint32_t value) {
   positionChanged(0);
 }
 
+void EncodeStream::setUint16(uint32_t position, uint16_t value) {
+  if (position + 2 <= _length) {
+    dataView.setUint16(position, value);
+  }
+}
+
+void EncodeStream::setUint32(uint32_t position, uint32_t value) {
+  if (position + 4 <= _length) {
+    dataView.setUint32(position, value);
+  }
+}
+
+void EncodeStream::setBytes(uint32_t position, EncodeStream* stream) {
+  if (position + stream->_length <= _length) {
+    memcpy(bytes + position, stream->bytes, stream->_length);
+  }
+}
+
+void EncodeStream::removeBytes(uint32_t offset, uint32_t length) {
+  if (offset >= _length) {
+    return;
+  }
+  if (length > _length - offset) {
+    length = static_cast<uint32_t>(_length - offset);
+  }
+  memmove(bytes + offset, bytes + offset + length, _length - offset - length);
+  _length -= length;
+  _position = _length;
+  _bitPosition = _position * 8;
+}
+
 void EncodeStream::writeBoolean(bool value) {
   if (checkCapacity(1)) {
     dataView.setBoolean(_position, value);
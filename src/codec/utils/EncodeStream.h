@@ -77,6 +77,30 @@ class EncodeStream final {
     _bitPosition = _position * 8;
   }
 
+  /**
+   * Overwrites an unsigned 16-bit integer at the specified position which has been written before.
+   * The current position will not change.
+   */
+  void setUint16(uint32_t position, uint16_t value);
+
+  /**
+   * Overwrites an unsigned 32-bit integer at the specified position which has been written before.
+   * The current position will not change.
+   */
+  void setUint32(uint32_t position, uint32_t value);
+
+  /**
+   * Overwrites the bytes at the specified position with all the bytes of the given stream. These
+   * bytes must have been written before. The current position will not change.
+   */
+  void setBytes(uint32_t position, EncodeStream* stream);
+
+  /**
+   * Removes length bytes starting at offset, and moves all the following bytes forward. The
+   * position is moved to the end of the stream.
+   */
+  void removeBytes(uint32_t offset, uint32_t length);
+
   /**
    * Writes a Boolean value. A signed 8-bit integer is written according to the value parameter,
    * either 1 if true or 0 if false.
@@ -31,6 +31,8 @@
 #include "platform/ohos/JsHelper.h"
 #include "rendering/utils/ApplyScaleMode.h"
 #include "tgfx/core/ColorType.h"
+#include "tgfx/core/Data.h"
+#include "tgfx/core/Pixmap.h"
 #include "tgfx/platform/ohos/OHOSPixelMap.h"
 
 namespace pag {
@@ -495,6 +497,10 @@ std::shared_ptr<PAGDecoder> JPAGImageView::getDecoderInternal() {
       scaleFactor = static_cast<float>(_renderScale * (_height * 1.0 / _composition->height()));
     }
     _decoder = PAGDecoder::MakeFrom(_composition, _frameRate, scaleFactor);
+    frameProvider = FrameProvider::Make(_decoder);
+    if (frameProvider != nullptr) {
+      frameProvider->setCacheAllFramesInMemory(_cacheAllFramesInMemory);
+    }
     refreshMatrixFromScaleMode();
   }
   return _decoder;
@@ -627,7 +633,7 @@ void JPAGImageView::invalidSize() {
 
 void JPAGImageView::invalidDecoder() {
   _decoder = nullptr;
-  images.clear();
+  frameProvider = nullptr;
 }
 
 std::shared_ptr<PAGAnimator> JPAGImageView::getAnimator() {
@@ -709,8 +715,8 @@ void JPAGImageView::setCacheAllFramesInMemory(bool cacheAllFramesInMemory) {
     return;
   }
   _cacheAllFramesInMemory = cacheAllFramesInMemory;
-  if (!_cacheAllFramesInMemory) {
-    images.clear();
+  if (frameProvider != nullptr) {
+    frameProvider->setCacheAllFramesInMemory(_cacheAllFramesInMemory);
   }
 }
 
@@ -741,45 +747,31 @@ void JPAGImageView::refreshMatrixFromScaleMode() {
 
 bool JPAGImageView::handleFrame(Frame frame) {
   auto decoder = getDecoderInternal();
-  if (!decoder) {
+  if (!decoder || frameProvider == nullptr) {
     return false;
   }
   if (!decoder->checkFrameChanged(frame)) {
     return true;
   }
-  auto image = getImage(frame);
-  if (!image.second) {
+  auto framePixels = frameProvider->readFrame(frame);
+  auto image = makeImage(framePixels);
+  if (!image) {
     return false;
   }
-  currentBitmap = image.first;
-  currentImage = image.second;
+  // Release the previous image before its pixels go back to the frame provider.
+  currentImage = image;
+  currentFrame = framePixels;
   return present(currentImage);
 }
 
-std::pair<tgfx::Bitmap, std::shared_ptr<tgfx::Image>> JPAGImageView::getImage(Frame frame) {
-  if (_cacheAllFramesInMemory && images.find(frame) != images.end()) {
-    return images[frame];
-  }
-
-  tgfx::Bitmap bitmap;
-  if (!bitmap.allocPixels(_decoder->width(), _decoder->height(), false, false)) {
-    return {{}, nullptr};
-  }
-  auto pixels = bitmap.lockPixels();
-  if (pixels == nullptr) {
-    return {{}, nullptr};
-  }
-  _decoder->readFrame(frame, pixels, bitmap.rowBytes());
-  bitmap.unlockPixels();
-  auto image = tgfx::Image::MakeFrom(bitmap);
-
-  if (image == nullptr) {
-    return {{}, nullptr};
-  }
-  if (_cacheAllFramesInMemory) {
-    images[frame] = {bitmap, image};
+std::shared_ptr<tgfx::Image> JPAGImageView::makeImage(std::shared_ptr<FramePixels> frame) {
+  if (frame == nullptr) {
+    return nullptr;
   }
-  return {bitmap, image};
+  // The image shares the pixels of the frame, which stay valid while currentFrame holds it.
+  auto& info = frame->info();
+  auto pixels = tgfx::Data::MakeWithoutCopy(frame->pixels(), info.byteSize());
+  return tgfx::Image::MakeFrom(info, std::move(pixels));
 }
 
 bool JPAGImageView::present(std::shared_ptr<tgfx::Image> image) {
@@ -820,24 +812,23 @@ bool JPAGImageView::present(std::shared_ptr<tgfx::Image> image) {
 
 napi_value JPAGImageView::getCurrentPixelMap(napi_env env) {
   std::lock_guard lock_guard(locker);
-  if (currentBitmap.isEmpty()) {
+  if (currentFrame == nullptr) {
     return nullptr;
   }
+  auto& info = currentFrame->info();
 
   // create PixelMap
   OhosPixelMapCreateOps ops;
-  ops.width = currentBitmap.width();
-  ops.height = currentBitmap.height();
-  ops.pixelFormat = currentBitmap.colorType() == tgfx::ColorType::RGBA_8888
+  ops.width = info.width();
+  ops.height = info.height();
+  ops.pixelFormat = info.colorType() == tgfx::ColorType::RGBA_8888
                         ? PIXEL_FORMAT_RGBA_8888
                         : PIXEL_FORMAT_BGRA_8888;
   ops.alphaType = OHOS_PIXEL_MAP_ALPHA_TYPE_PREMUL;
   ops.editable = false;
   napi_value pixelMap;
-  auto pixels = currentBitmap.lockPixels();
-  auto status = OH_PixelMap_CreatePixelMapWithStride(env, ops, pixels, currentBitmap.byteSize(),
-                                                     currentBitmap.rowBytes(), &pixelMap);
-  currentBitmap.unlockPixels();
+  auto status = OH_PixelMap_CreatePixelMapWithStride(env, ops, currentFrame->pixels(),
+                                                     info.byteSize(), info.rowBytes(), &pixelMap);
 
   // readPixels
   auto nativePixelMap = OH_PixelMap_InitNativePixelMap(env, pixelMap);
@@ -846,7 +837,7 @@ napi_value JPAGImageView::getCurrentPixelMap(napi_env env) {
   }
   void* pixelMapAddress = nullptr;
   OH_PixelMap_AccessPixels(nativePixelMap, &pixelMapAddress);
-  currentBitmap.readPixels(currentBitmap.info(), pixelMapAddress);
+  tgfx::Pixmap(info, currentFrame->pixels()).readPixels(info, pixelMapAddress);
   OH_PixelMap_UnAccessPixels(nativePixelMap);
   if (status == napi_ok) {
     return pixelMap;
@@ -22,6 +22,7 @@
 #include "pag/pag.h"
 #include "platform/ohos/XComponentHandler.h"
 #include "rendering/PAGAnimator.h"
+#include "rendering/caches/FrameProvider.h"
 #include "tgfx/gpu/Window.h"
 
 namespace pag {
@@ -105,7 +106,7 @@ class JPAGImageView : public PAGAnimator::Listener, public XComponentListener {
 
   bool handleFrame(Frame frame);
 
-  std::pair<tgfx::Bitmap, std::shared_ptr<tgfx::Image>> getImage(Frame frame);
+  std::shared_ptr<tgfx::Image> makeImage(std::shared_ptr<FramePixels> frame);
 
   bool present(std::shared_ptr<tgfx::Image> image);
 
@@ -120,13 +121,12 @@ class JPAGImageView : public PAGAnimator::Listener, public XComponentListener {
   std::shared_ptr<PAGComposition> _composition = nullptr;
   std::shared_ptr<PAGAnimator> _animator = nullptr;
   std::shared_ptr<PAGDecoder> _decoder = nullptr;
+  std::shared_ptr<FrameProvider> frameProvider = nullptr;
 
   NativeWindow* _window = nullptr;
   std::shared_ptr<tgfx::Window> targetWindow = nullptr;
 
   std::shared_ptr<tgfx::Image> currentImage = nullptr;
-  tgfx::Bitmap currentBitmap;
-
-  std::unordered_map<Frame, std::pair<tgfx::Bitmap, std::shared_ptr<tgfx::Image>>> images;
+  std::shared_ptr<FramePixels> currentFrame = nullptr;
 };
 }  // namespace pag
@@ -37,6 +37,11 @@ class HardwareDecoderFactory : public VideoDecoderFactory {
     return true;
   }
 
+  // The decoder is bound to the demuxer of the video sequence.
+  bool canReuseDecoders() const override {
+    return false;
+  }
+
  protected:
   std::unique_ptr<VideoDecoder> onCreateDecoder(const VideoFormat& format) const override {
     if (format.demuxer == nullptr) {
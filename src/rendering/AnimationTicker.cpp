@@ -0,0 +1,192 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "AnimationTicker.h"
+#include <algorithm>
+#include "platform/Platform.h"
+#include "rendering/utils/DisplayLinkWrapper.h"
+#include "tgfx/core/Clock.h"
+
+namespace pag {
+// 没有测量到帧间隔时，按 60fps 估算每帧的时间预算。
+static constexpr int64_t DEFAULT_FRAME_INTERVAL = 16667;
+// 连续这么多帧没有超载后才降低一级负载，避免在临界状态来回抖动。
+static constexpr int LOAD_RECOVERY_FRAMES = 60;
+
+AnimationTicker* AnimationTicker::GetInstance() {
+  static auto& instance = *new AnimationTicker();
+  return &instance;
+}
+
+AnimationTicker::AnimationTicker() {
+  auto callback = [this] { onFrameAvailable(); };
+  platformDisplayLink = DisplayLinkWrapper::Make(callback);
+  if (platformDisplayLink == nullptr) {
+    platformDisplayLink = Platform::Current()->createDisplayLink(callback);
+  }
+}
+
+bool AnimationTicker::available() {
+  return currentDisplayLink() != nullptr;
+}
+
+int64_t AnimationTicker::now() {
+  locker.lock();
+  auto displayLink = virtualDisplayLink;
+  locker.unlock();
+  return displayLink ? displayLink->now() : tgfx::Clock::Now();
+}
+
+int AnimationTicker::loadLevel() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _loadLevel;
+}
+
+void AnimationTicker::addAnimator(std::shared_ptr<PAGAnimator> animator) {
+  locker.lock();
+  auto needStart = animators.empty();
+  // 错开每个动画的起始相位，同时加入的低优先级动画在降频时不会挤在同一帧里刷新。
+  animator->framePhase = nextFramePhase++;
+  animators.push_back(std::move(animator));
+  locker.unlock();
+  auto displayLink = currentDisplayLink();
+  if (needStart && displayLink) {
+    displayLink->start();
+  }
+}
+
+void AnimationTicker::removeAnimator(std::shared_ptr<PAGAnimator> animator) {
+  locker.lock();
+  auto index = std::find(animators.begin(), animators.end(), animator);
+  if (index != animators.end()) {
+    animators.erase(index);
+  }
+  auto needStop = animators.empty();
+  if (needStop) {
+    lastFrameTime = INT64_MIN;
+    _loadLevel = 0;
+    idleFrames = 0;
+  }
+  locker.unlock();
+  auto displayLink = currentDisplayLink();
+  if (needStop && displayLink) {
+    displayLink->stop();
+  }
+}
+
+std::shared_ptr<VirtualDisplayLink> AnimationTicker::useVirtualDisplayLink(int64_t frameInterval) {
+  std::shared_ptr<VirtualDisplayLink> displayLink = nullptr;
+  if (frameInterval > 0) {
+    displayLink = VirtualDisplayLink::Make([this] { onFrameAvailable(); }, frameInterval,
+                                           tgfx::Clock::Now());
+  }
+  locker.lock();
+  std::shared_ptr<DisplayLink> oldDisplayLink = virtualDisplayLink;
+  if (oldDisplayLink == nullptr) {
+    oldDisplayLink = platformDisplayLink;
+  }
+  virtualDisplayLink = displayLink;
+  lastFrameTime = INT64_MIN;
+  auto running = !animators.empty();
+  locker.unlock();
+  if (running) {
+    if (oldDisplayLink) {
+      oldDisplayLink->stop();
+    }
+    auto newDisplayLink = currentDisplayLink();
+    if (newDisplayLink) {
+      newDisplayLink->start();
+    }
+  }
+  return displayLink;
+}
+
+std::shared_ptr<DisplayLink> AnimationTicker::currentDisplayLink() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (virtualDisplayLink) {
+    return virtualDisplayLink;
+  }
+  return platformDisplayLink;
+}
+
+void AnimationTicker::onFrameAvailable() {
+  auto frameTime = now();
+  locker.lock();
+  auto listCopy = animators;
+  int64_t frameInterval = DEFAULT_FRAME_INTERVAL;
+  if (virtualDisplayLink) {
+    frameInterval = virtualDisplayLink->frameInterval();
+  } else if (lastFrameTime != INT64_MIN) {
+    frameInterval = frameTime - lastFrameTime;
+  }
+  lastFrameTime = frameTime;
+  auto decimation = static_cast<int64_t>(1) << _loadLevel;
+  auto frameIndex = tickCount++;
+  std::vector<bool> lowPriorityFrames = {};
+  lowPriorityFrames.reserve(listCopy.size());
+  for (auto& animator : listCopy) {
+    lowPriorityFrames.push_back(((frameIndex + animator->framePhase) % decimation) == 0);
+  }
+  locker.unlock();
+  // 先按优先级排好序再统一派发，高优先级的动画先占用渲染线程。
+  struct FrameItem {
+    PAGAnimator::Priority priority;
+    bool lowPriorityFrame;
+    std::shared_ptr<PAGAnimator> animator;
+  };
+  std::vector<FrameItem> batch = {};
+  batch.reserve(listCopy.size());
+  for (size_t i = 0; i < listCopy.size(); i++) {
+    auto& animator = listCopy[i];
+    if (animator.use_count() == 1) {
+      animator->cancelAnimation();
+      continue;
+    }
+    batch.push_back({animator->priority(), lowPriorityFrames[i], animator});
+  }
+  std::stable_sort(batch.begin(), batch.end(), [](const FrameItem& a, const FrameItem& b) {
+    return a.priority > b.priority;
+  });
+  auto busyAnimators = 0;
+  // 使用虚拟时钟时，派发耗时也按虚拟时钟计算，这样负载的变化完全由调用方决定。
+  auto startTime = now();
+  for (auto& item : batch) {
+    if (item.animator->isFlushing()) {
+      busyAnimators++;
+    }
+    auto render = item.priority != PAGAnimator::Priority::Low || item.lowPriorityFrame;
+    item.animator->advance(render);
+  }
+  auto dispatchTime = now() - startTime;
+  // 上一帧的异步渲染还没结束，或者同步渲染已经超出了帧间隔，都说明当前负载过高。
+  updateLoadLevel(busyAnimators > 0 || dispatchTime > frameInterval);
+}
+
+void AnimationTicker::updateLoadLevel(bool overloaded) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (overloaded) {
+    idleFrames = 0;
+    _loadLevel = std::min(_loadLevel + 1, MaxLoadLevel);
+    return;
+  }
+  if (_loadLevel > 0 && ++idleFrames >= LOAD_RECOVERY_FRAMES) {
+    idleFrames = 0;
+    _loadLevel--;
+  }
+}
+}  // namespace pag
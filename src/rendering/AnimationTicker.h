@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "rendering/PAGAnimator.h"
+#include "rendering/utils/DisplayLink.h"
+#include "rendering/utils/VirtualDisplayLink.h"
+
+namespace pag {
+/**
+ * AnimationTicker drives all running PAGAnimators from one shared display link. On every frame, it
+ * dispatches the animators in priority order and keeps track of the current load. When the frames
+ * fall behind, low-priority animators are decimated to leave the frame budget to the others.
+ */
+class AnimationTicker {
+ public:
+  static AnimationTicker* GetInstance();
+
+  bool available();
+
+  /**
+   * Returns the current time used to schedule animations, in microseconds. This is the virtual
+   * clock if a virtual display link is in use, otherwise the monotonic system clock.
+   */
+  int64_t now();
+
+  /**
+   * Returns the current load level, ranging from 0 to MaxLoadLevel. Low-priority animators only
+   * render one frame out of every 2^loadLevel frames.
+   */
+  int loadLevel();
+
+  void addAnimator(std::shared_ptr<PAGAnimator> animator);
+
+  void removeAnimator(std::shared_ptr<PAGAnimator> animator);
+
+  /**
+   * Replaces the platform display link with a virtual one that advances frameInterval microseconds
+   * per tick, and returns it. Passing a non-positive frameInterval restores the platform display
+   * link and returns nullptr.
+   */
+  std::shared_ptr<VirtualDisplayLink> useVirtualDisplayLink(int64_t frameInterval);
+
+  static constexpr int MaxLoadLevel = 3;
+
+ private:
+  std::mutex locker = {};
+  std::shared_ptr<DisplayLink> platformDisplayLink = nullptr;
+  std::shared_ptr<VirtualDisplayLink> virtualDisplayLink = nullptr;
+  std::vector<std::shared_ptr<PAGAnimator>> animators = {};
+  int64_t tickCount = 0;
+  int64_t nextFramePhase = 0;
+  int64_t lastFrameTime = INT64_MIN;
+  int _loadLevel = 0;
+  int idleFrames = 0;
+
+  AnimationTicker();
+  std::shared_ptr<DisplayLink> currentDisplayLink();
+  void onFrameAvailable();
+  void updateLoadLevel(bool overloaded);
+};
+}  // namespace pag
@@ -95,6 +95,8 @@ PAGFont FontManager::registerFont(std::shared_ptr<tgfx::Typeface> typeface,
     registeredFontMap.erase(iter);
   }
   registeredFontMap[key] = std::move(typeface);
+  // 注册字体通常意味着可用的字体发生了变化，之前记录的系统字体查询结果（包括查询失败的）需要重新查询。
+  resetSystemFonts();
   return {family, style};
 }
 
@@ -124,9 +126,20 @@ static std::shared_ptr<tgfx::Typeface> MakeTypefaceWithName(const std::string& f
 std::shared_ptr<tgfx::Typeface> FontManager::getTypefaceWithoutFallback(
     const std::string& fontFamily, const std::string& fontStyle) {
   std::shared_ptr<tgfx::Typeface> typeface = getTypefaceFromCache(fontFamily, fontStyle);
-  if (typeface == nullptr) {
-    typeface = MakeTypefaceWithName(fontFamily, fontStyle);
+  if (typeface != nullptr) {
+    return typeface;
+  }
+  auto key = PAGFontRegisterKey(fontFamily, fontStyle);
+  uint32_t version = 0;
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = systemFontMap.find(key);
+    if (result != systemFontMap.end()) {
+      return result->second;
+    }
+    version = systemFontVersion;
   }
+  typeface = MakeTypefaceWithName(fontFamily, fontStyle);
   if (typeface == nullptr) {
     auto index = fontFamily.find(' ');
     if (index != std::string::npos) {
@@ -135,6 +148,13 @@ std::shared_ptr<tgfx::Typeface> FontManager::getTypefaceWithoutFallback(
       typeface = MakeTypefaceWithName(family, style);
     }
   }
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (version == systemFontVersion) {
+    if (systemFontMap.size() >= MaxSystemFontCount) {
+      resetSystemFonts();
+    }
+    systemFontMap[key] = typeface;
+  }
   return typeface;
 }
 
@@ -143,9 +163,60 @@ std::vector<std::shared_ptr<TypefaceHolder>> FontManager::getFallbackTypefaces()
   return fallbackFontList;
 }
 
-void FontManager::setFallbackFontNames(const std::vector<std::string>& fontNames) {
+std::shared_ptr<tgfx::Typeface> FontManager::getFallbackTypeface(const std::string& name,
+                                                                 tgfx::GlyphID* glyphID) {
+  std::vector<std::shared_ptr<TypefaceHolder>> typefaces;
+  uint32_t version = 0;
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = fallbackGlyphMap.find(name);
+    if (result != fallbackGlyphMap.end()) {
+      *glyphID = result->second.glyphID;
+      return result->second.typeface;
+    }
+    typefaces = fallbackFontList;
+    version = fallbackVersion;
+  }
+  // 加载字体可能比较耗时，不持有锁。
+  FallbackGlyph glyph = {};
+  for (const auto& faceHolder : typefaces) {
+    auto face = faceHolder->getTypeface();
+    if (face == nullptr) {
+      continue;
+    }
+    auto id = face->getGlyphID(name);
+    if (id != 0) {
+      glyph.typeface = std::move(face);
+      glyph.glyphID = id;
+      break;
+    }
+  }
   std::lock_guard<std::mutex> autoLock(locker);
+  if (version == fallbackVersion) {
+    if (fallbackGlyphMap.size() >= MaxFallbackGlyphCount) {
+      fallbackGlyphMap.clear();
+    }
+    fallbackGlyphMap[name] = glyph;
+  }
+  *glyphID = glyph.glyphID;
+  return glyph.typeface;
+}
+
+void FontManager::resetFallbackFonts() {
   fallbackFontList.clear();
+  fallbackGlyphMap.clear();
+  fallbackVersion++;
+  resetSystemFonts();
+}
+
+void FontManager::resetSystemFonts() {
+  systemFontMap.clear();
+  systemFontVersion++;
+}
+
+void FontManager::setFallbackFontNames(const std::vector<std::string>& fontNames) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  resetFallbackFonts();
   for (auto& fontFamily : fontNames) {
     auto holder = TypefaceHolder::MakeFromName(fontFamily, "");
     fallbackFontList.push_back(holder);
@@ -155,7 +226,7 @@ void FontManager::setFallbackFontNames(const std::vector<std::string>& fontNames
 void FontManager::setFallbackFontPaths(const std::vector<std::string>& fontPaths,
                                        const std::vector<int>& ttcIndices) {
   std::lock_guard<std::mutex> autoLock(locker);
-  fallbackFontList.clear();
+  resetFallbackFonts();
   int index = 0;
   for (auto& fontPath : fontPaths) {
     auto holder = TypefaceHolder::MakeFromFile(fontPath, ttcIndices[index]);
@@ -188,12 +259,22 @@ static bool RegisterFallbackFonts() {
   return Platform::Current()->registerFallbackFonts();
 }
 
-std::vector<std::shared_ptr<TypefaceHolder>> FontManager::GetFallbackTypefaces() {
+static void InitFallbackFonts() {
   static auto registered = RegisterFallbackFonts();
   USE(registered);
+}
+
+std::vector<std::shared_ptr<TypefaceHolder>> FontManager::GetFallbackTypefaces() {
+  InitFallbackFonts();
   return fontManager.getFallbackTypefaces();
 }
 
+std::shared_ptr<tgfx::Typeface> FontManager::GetFallbackTypeface(const std::string& name,
+                                                                 tgfx::GlyphID* glyphID) {
+  InitFallbackFonts();
+  return fontManager.getFallbackTypeface(name, glyphID);
+}
+
 PAGFont FontManager::RegisterFont(const std::string& fontPath, int ttcIndex,
                                   const std::string& fontFamily, const std::string& fontStyle) {
   return fontManager.registerFont(fontPath, ttcIndex, fontFamily, fontStyle);
@@ -49,6 +49,14 @@ class FontManager {
 
   static std::vector<std::shared_ptr<TypefaceHolder>> GetFallbackTypefaces();
 
+  /**
+   * Returns the first fallback typeface that contains the glyph of the specified character, and
+   * writes the glyph id into glyphID. Returns nullptr if none of the fallback typefaces contains
+   * it. The results are cached per character until the fallback fonts change.
+   */
+  static std::shared_ptr<tgfx::Typeface> GetFallbackTypeface(const std::string& name,
+                                                             tgfx::GlyphID* glyphID);
+
   static PAGFont RegisterFont(const std::string& fontPath, int ttcIndex,
                               const std::string& fontFamily, const std::string& fontStyle);
 
@@ -83,15 +91,39 @@ class FontManager {
 
   std::vector<std::shared_ptr<TypefaceHolder>> getFallbackTypefaces();
 
+  std::shared_ptr<tgfx::Typeface> getFallbackTypeface(const std::string& name,
+                                                      tgfx::GlyphID* glyphID);
+
   void setFallbackFontNames(const std::vector<std::string>& fontNames);
 
   void setFallbackFontPaths(const std::vector<std::string>& fontPaths,
                             const std::vector<int>& ttcIndices);
 
+  static constexpr size_t MaxSystemFontCount = 128;
+  // 大约覆盖常用汉字的数量，超过时整体清空，避免大量不同字符的文本让缓存无限增长。
+  static constexpr size_t MaxFallbackGlyphCount = 4096;
+
+  struct FallbackGlyph {
+    std::shared_ptr<tgfx::Typeface> typeface = nullptr;
+    tgfx::GlyphID glyphID = 0;
+  };
+
   std::unordered_map<std::string, std::shared_ptr<tgfx::Typeface>> registeredFontMap;
+  // 系统字体的查询结果，查询失败时也会记录 nullptr，避免重复调用 Typeface::MakeFromName()。
+  // 注册字体或者 fallback 列表变化时清空，数量超过 MaxSystemFontCount 时也会整体清空。
+  std::unordered_map<std::string, std::shared_ptr<tgfx::Typeface>> systemFontMap;
+  uint32_t systemFontVersion = 0;
   std::vector<std::shared_ptr<TypefaceHolder>> fallbackFontList;
+  // 每个字符命中的 fallback 字体，fallback 列表变化时清空，
+  // 数量超过 MaxFallbackGlyphCount 时也会整体清空。
+  std::unordered_map<std::string, FallbackGlyph> fallbackGlyphMap;
+  uint32_t fallbackVersion = 0;
   std::mutex locker = {};
 
+  void resetFallbackFonts();
+
+  void resetSystemFonts();
+
   std::shared_ptr<tgfx::Typeface> getTypefaceFromCache(const std::string& fontFamily,
                                                        const std::string& fontStyle);
 
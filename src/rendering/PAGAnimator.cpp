@@ -17,9 +17,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "PAGAnimator.h"
+#include <algorithm>
 #include "base/utils/TimeUtil.h"
-#include "platform/Platform.h"
-#include "rendering/utils/DisplayLinkWrapper.h"
+#include "rendering/AnimationTicker.h"
 #include "tgfx/core/Clock.h"
 #include "tgfx/core/Task.h"
 
@@ -28,67 +28,6 @@ static constexpr int AnimationTypeEnd = 1;
 static constexpr int AnimationTypeRepeat = 2;
 static constexpr int AnimationTypeUpdate = 3;
 
-class AnimationTicker {
- public:
-  static AnimationTicker* GetInstance() {
-    static auto& instance = *new AnimationTicker();
-    return &instance;
-  }
-
-  AnimationTicker() {
-    auto callback = [this] { onFrameAvailable(); };
-    displayLink = DisplayLinkWrapper::Make(callback);
-    if (displayLink == nullptr) {
-      displayLink = Platform::Current()->createDisplayLink(callback);
-    }
-  }
-
-  bool available() {
-    return displayLink != nullptr;
-  }
-
-  void addAnimator(std::shared_ptr<PAGAnimator> animator) {
-    locker.lock();
-    auto needStart = animators.empty();
-    animators.push_back(std::move(animator));
-    locker.unlock();
-    if (needStart) {
-      displayLink->start();
-    }
-  }
-
-  void removeAnimator(std::shared_ptr<PAGAnimator> animator) {
-    locker.lock();
-    auto index = std::find(animators.begin(), animators.end(), animator);
-    if (index != animators.end()) {
-      animators.erase(index);
-    }
-    auto needStop = animators.empty();
-    locker.unlock();
-    if (needStop) {
-      displayLink->stop();
-    }
-  }
-
- private:
-  std::mutex locker = {};
-  std::shared_ptr<DisplayLink> displayLink = nullptr;
-  std::vector<std::shared_ptr<PAGAnimator>> animators = {};
-
-  void onFrameAvailable() {
-    locker.lock();
-    auto listCopy = animators;
-    locker.unlock();
-    for (auto& animator : listCopy) {
-      if (animator.use_count() == 1) {
-        animator->cancelAnimation();
-        continue;
-      }
-      animator->advance();
-    }
-  }
-};
-
 std::shared_ptr<PAGAnimator> PAGAnimator::MakeFrom(std::weak_ptr<Listener> listener) {
   if (listener.expired() || !AnimationTicker::GetInstance()->available()) {
     return nullptr;
@@ -121,6 +60,41 @@ void PAGAnimator::setSync(bool value) {
   }
 }
 
+PAGAnimator::Priority PAGAnimator::priority() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _priority;
+}
+
+void PAGAnimator::setPriority(Priority value) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  _priority = value;
+}
+
+bool PAGAnimator::isVisible() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _isVisible;
+}
+
+void PAGAnimator::setVisible(bool value) {
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (_isVisible == value) {
+      return;
+    }
+    _isVisible = value;
+    if (!value || !_isRunning) {
+      return;
+    }
+  }
+  // 重新可见时立即刷新一帧，不用等到下一次 vsync。
+  doUpdate(false);
+}
+
+PAGAnimator::FrameStatistics PAGAnimator::statistics() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return frameStatistics;
+}
+
 int64_t PAGAnimator::duration() {
   std::lock_guard<std::mutex> autoLock(locker);
   return _duration;
@@ -211,12 +185,29 @@ void PAGAnimator::update() {
   doUpdate(false);
 }
 
-void PAGAnimator::advance() {
+bool PAGAnimator::isFlushing() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return task != nullptr && task->executing();
+}
+
+void PAGAnimator::advance(bool render) {
   auto events = doAdvance();
   auto listener = weakListener.lock();
   if (listener == nullptr) {
     return;
   }
+  // 最后一帧必须刷新，否则动画会停在被跳过的中间帧上。
+  if (std::find(events.begin(), events.end(), AnimationTypeEnd) != events.end()) {
+    render = true;
+  }
+  if (!render || !isVisible()) {
+    for (auto& type : events) {
+      if (type == AnimationTypeUpdate) {
+        skipUpdate();
+      }
+    }
+    render = false;
+  }
   for (auto& type : events) {
     switch (type) {
       case AnimationTypeEnd:
@@ -226,7 +217,9 @@ void PAGAnimator::advance() {
         listener->onAnimationRepeat(this);
         break;
       case AnimationTypeUpdate:
-        doUpdate(true);
+        if (render) {
+          doUpdate(true);
+        }
       default:
         break;
     }
@@ -243,7 +236,7 @@ std::vector<int> PAGAnimator::doAdvance() {
     playTime =
         static_cast<int64_t>(_progress * static_cast<double>(_duration)) + playedCount * _duration;
   } else {
-    playTime = tgfx::Clock::Now() - _startTime;
+    playTime = AnimationTicker::GetInstance()->now() - _startTime;
     auto fraction = static_cast<double>(playTime) / static_cast<double>(_duration);
     if (fraction < 0) {
       fraction = 0;
@@ -276,6 +269,7 @@ std::vector<int> PAGAnimator::doAdvance() {
 void PAGAnimator::doUpdate(bool setStartTime) {
   locker.lock();
   if (task != nullptr && task->executing()) {
+    frameStatistics.droppedFrames++;
     locker.unlock();
     return;
   }
@@ -299,13 +293,34 @@ void PAGAnimator::doUpdate(bool setStartTime) {
 
 void PAGAnimator::onFlush(bool setStartTime) {
   auto listener = weakListener.lock();
+  int64_t frameTime = 0;
   if (listener) {
+    auto startTime = tgfx::Clock::Now();
     listener->onAnimationUpdate(this);
+    frameTime = tgfx::Clock::Now() - startTime;
   }
+  auto now = AnimationTicker::GetInstance()->now();
   std::lock_guard<std::mutex> autoLock(locker);
-  if (setStartTime && _startTime == INT64_MIN) {
-    _startTime = tgfx::Clock::Now() -
-                 static_cast<int64_t>(_progress * static_cast<double>(_duration)) -
+  frameStatistics.renderedFrames++;
+  totalFrameTime += frameTime;
+  frameStatistics.averageFrameTime = totalFrameTime / frameStatistics.renderedFrames;
+  frameStatistics.maxFrameTime = std::max(frameStatistics.maxFrameTime, frameTime);
+  if (setStartTime) {
+    checkStartTime(now);
+  }
+}
+
+void PAGAnimator::skipUpdate() {
+  auto now = AnimationTicker::GetInstance()->now();
+  std::lock_guard<std::mutex> autoLock(locker);
+  frameStatistics.skippedFrames++;
+  // 跳过的帧也要开始计时，否则动画进度不会前进。
+  checkStartTime(now);
+}
+
+void PAGAnimator::checkStartTime(int64_t now) {
+  if (_startTime == INT64_MIN) {
+    _startTime = now - static_cast<int64_t>(_progress * static_cast<double>(_duration)) -
                  playedCount * _duration;
   }
 }
@@ -78,6 +78,38 @@ class PAGAnimator {
     friend class PAGAnimator;
   };
 
+  /**
+   * The scheduling priority of an animator. When the frames fall behind, animators with the Low
+   * priority skip some of their frames, and animators with the High priority are dispatched first.
+   */
+  enum class Priority { Low, Normal, High };
+
+  /**
+   * The frame statistics of an animator, with times in microseconds.
+   */
+  struct FrameStatistics {
+    /**
+     * The number of frames that have been flushed.
+     */
+    int renderedFrames = 0;
+    /**
+     * The number of frames dropped because the previous frame was still flushing.
+     */
+    int droppedFrames = 0;
+    /**
+     * The number of frames skipped because the animator was invisible or decimated under load.
+     */
+    int skippedFrames = 0;
+    /**
+     * The average time of flushing a frame.
+     */
+    int64_t averageFrameTime = 0;
+    /**
+     * The maximum time of flushing a frame.
+     */
+    int64_t maxFrameTime = 0;
+  };
+
   /**
    * Creates a new PAGAnimator with the specified listener.
    */
@@ -93,6 +125,32 @@ class PAGAnimator {
    */
   void setSync(bool value);
 
+  /**
+   * Returns the scheduling priority of the animation. The default value is Priority::Normal.
+   */
+  Priority priority();
+
+  /**
+   * Sets the scheduling priority of the animation.
+   */
+  void setPriority(Priority value);
+
+  /**
+   * Indicates whether the animation is visible on the screen. The default value is true.
+   */
+  bool isVisible();
+
+  /**
+   * Sets whether the animation is visible on the screen. An invisible animation keeps its timing
+   * but skips flushing frames until it becomes visible again.
+   */
+  void setVisible(bool value);
+
+  /**
+   * Returns the frame statistics collected since the animator was created.
+   */
+  FrameStatistics statistics();
+
   /**
    * Returns the length of the animation in microseconds.
    */
@@ -165,11 +223,20 @@ class PAGAnimator {
   bool isAnimating = false;
   bool isEnded = false;
   int playedCount = 0;
+  Priority _priority = Priority::Normal;
+  bool _isVisible = true;
+  FrameStatistics frameStatistics = {};
+  int64_t totalFrameTime = 0;
+  // Assigned by AnimationTicker to stagger the decimated frames of low-priority animators.
+  int64_t framePhase = 0;
 
   explicit PAGAnimator(std::weak_ptr<Listener> listener);
-  void advance();
+  bool isFlushing();
+  void advance(bool render = true);
   std::vector<int> doAdvance();
   void doUpdate(bool setStartTime);
+  void skipUpdate();
+  void checkStartTime(int64_t now);
   void onFlush(bool setStartTime);
   void startAnimation();
   void cancelAnimation();
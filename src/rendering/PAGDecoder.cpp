@@ -72,9 +72,75 @@ std::pair<int, float> PAGDecoder::GetFrameCountAndRate(
   return {numFrames, frameRate};
 }
 
+std::vector<TimeRange> PAGDecoder::GetFileStaticTimeRange(PAGComposition* pagFile,
+                                                          int numFrames) {
+  // The static time ranges of an unmodified file are already known from decoding, so we only need
+  // to map each decoded frame to its composition frame instead of visiting every layer by
+  // gotoTime().
+  auto preComposeLayer = static_cast<PreComposeLayer*>(pagFile->layer);
+  auto& compositionRanges = preComposeLayer->composition->staticTimeRanges;
+  auto frameRate = pagFile->frameRateInternal();
+  auto startTime = pagFile->startTimeInternal();
+  auto duration = pagFile->durationInternal();
+  auto compositionOffset =
+      preComposeLayer->compositionStartTime - preComposeLayer->startTime + pagFile->startFrame;
+  auto compositionOffsetTime =
+      static_cast<Frame>(floor(compositionOffset * 1000000.0 / frameRate));
+  auto getStaticFrame = [&](int index) {
+    auto progress = FrameToProgress(static_cast<Frame>(index), numFrames);
+    auto layerTime = startTime + ProgressToTime(progress, duration);
+    auto compositionFrame = TimeToFrame(layerTime - compositionOffsetTime, frameRate);
+    return ConvertFrameByStaticTimeRanges(compositionRanges, compositionFrame);
+  };
+  std::vector<TimeRange> timeRanges = {};
+  TimeRange timeRange = {0, 0};
+  auto lastFrame = getStaticFrame(0);
+  for (int i = 1; i < numFrames; i++) {
+    auto frame = getStaticFrame(i);
+    if (frame == lastFrame) {
+      timeRange.end++;
+      continue;
+    }
+    lastFrame = frame;
+    if (timeRange.duration() > 1) {
+      timeRanges.push_back(timeRange);
+    }
+    timeRange = {i, i};
+  }
+  if (timeRange.duration() > 1) {
+    timeRanges.push_back(timeRange);
+  }
+  return timeRanges;
+}
+
+bool PAGDecoder::HasExcludedLayers(PAGComposition* composition) {
+  // A layer excluded from the timeline keeps its own time, which the static time ranges decoded
+  // from the file know nothing about.
+  for (auto& layer : composition->layers) {
+    if (layer->_excludedFromTimeline) {
+      return true;
+    }
+    if (layer->layerType() == LayerType::PreCompose &&
+        HasExcludedLayers(static_cast<PAGComposition*>(layer.get()))) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::vector<TimeRange> PAGDecoder::GetStaticTimeRange(std::shared_ptr<PAGComposition> composition,
                                                       int numFrames) {
   LockGuard autoLock(composition->rootLocker);
+  if (composition->isPAGFile() && composition->contentVersion == 0 &&
+      composition->stretchedFrameDuration() == composition->frameDuration() &&
+      !HasExcludedLayers(composition.get())) {
+    return GetFileStaticTimeRange(composition.get(), numFrames);
+  }
+  return ScanStaticTimeRange(composition.get(), numFrames);
+}
+
+std::vector<TimeRange> PAGDecoder::ScanStaticTimeRange(PAGComposition* composition,
+                                                       int numFrames) {
   std::vector<TimeRange> timeRanges = {};
   auto startTime = composition->startTimeInternal();
   auto duration = composition->durationInternal();
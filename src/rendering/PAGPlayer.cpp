@@ -132,6 +132,16 @@ void PAGPlayer::setUseDiskCache(bool value) {
   renderCache->setUseDiskCache(value);
 }
 
+bool PAGPlayer::adaptiveQuality() {
+  LockGuard autoLock(rootLocker);
+  return renderCache->adaptiveQuality();
+}
+
+void PAGPlayer::setAdaptiveQuality(bool value) {
+  LockGuard autoLock(rootLocker);
+  renderCache->setAdaptiveQuality(value);
+}
+
 float PAGPlayer::cacheScale() {
   LockGuard autoLock(rootLocker);
   return stage->cacheScale();
@@ -265,6 +275,14 @@ void PAGPlayer::prepare() {
   renderCache->prepareLayers();
 }
 
+int PAGPlayer::warmUp() {
+  LockGuard autoLock(rootLocker);
+  if (pagSurface == nullptr) {
+    return -1;
+  }
+  return pagSurface->warmUp(renderCache);
+}
+
 void PAGPlayer::prepareInternal() {
   renderCache->beginFrame();
   auto result = updateStageSize();
@@ -312,6 +330,13 @@ bool PAGPlayer::flushInternal(BackendSemaphore* signalSemaphore) {
                    renderCache->softwareDecodingTime;
   renderCache->presentingTime -= knownTime;
   renderCache->totalTime = clock.measure("", "presenting");
+  if (renderCache->adaptiveQuality()) {
+    auto composition = stage->getRootComposition();
+    if (composition) {
+      auto frameInterval = static_cast<int64_t>(1000000 / composition->frameRateInternal());
+      renderCache->updateFilterQuality(renderCache->totalTime, frameInterval);
+    }
+  }
   //  auto composition = stage->getRootComposition();
   //  if (composition) {
   //    renderCache->printPerformance(composition->currentFrameInternal());
@@ -359,21 +384,53 @@ std::vector<std::shared_ptr<PAGLayer>> PAGPlayer::getLayersUnderPoint(float surf
 
 bool PAGPlayer::hitTestPoint(std::shared_ptr<PAGLayer> pagLayer, float surfaceX, float surfaceY,
                              bool pixelHitTest) {
-  LockGuard autoLock(rootLocker);
-  updateStageSize();
-  auto local = pagLayer->globalToLocalPoint(surfaceX, surfaceY);
-  if (!pixelHitTest) {
-    tgfx::Rect bounds = {};
-    pagLayer->measureBounds(&bounds);
-    return bounds.contains(local.x, local.y);
+  Point local = {};
+  std::shared_ptr<Graphic> graphic = nullptr;
+  {
+    LockGuard autoLock(rootLocker);
+    updateStageSize();
+    local = pagLayer->globalToLocalPoint(surfaceX, surfaceY);
+    if (!pixelHitTest) {
+      tgfx::Rect bounds = {};
+      pagLayer->measureBounds(&bounds);
+      return bounds.contains(local.x, local.y);
+    }
+    if (pagSurface == nullptr || pagLayer->getStage() != stage.get()) {
+      return false;
+    }
+    // The content graphic is recorded once and kept by the stage until the layer changes, so that
+    // the repeated hit tests between two changes only look it up while holding the root locker.
+    // Compositions record their children from the graphics retained by the last flush().
+    graphic = stage->getHitTestGraphic(pagLayer.get());
+    if (graphic == nullptr) {
+      Recorder recorder = {};
+      pagLayer->draw(&recorder);
+      graphic = recorder.makeGraphic();
+      stage->setHitTestGraphic(pagLayer.get(), graphic);
+    }
   }
-
-  if (pagSurface == nullptr || pagLayer->getStage() != stage.get()) {
+  // The graphic is immutable, so the CPU tests below run without holding the root locker and never
+  // wait for a flush() on another thread.
+  if (graphic == nullptr) {
+    return false;
+  }
+  tgfx::Rect bounds = {};
+  graphic->measureBounds(&bounds);
+  // Path.contains() includes the right and bottom edges, while Rect.contains() does not.
+  if (local.x < bounds.left || local.x > bounds.right || local.y < bounds.top ||
+      local.y > bounds.bottom) {
+    return false;
+  }
+  // Opaque vector contents can be tested against their paths on the CPU, only the others need to
+  // read pixels back from the GPU, which shares the render cache with flush().
+  tgfx::Path path = {};
+  if (graphic->getPath(&path)) {
+    return path.contains(local.x, local.y);
+  }
+  LockGuard autoLock(rootLocker);
+  if (pagSurface == nullptr) {
     return false;
   }
-  Recorder recorder = {};
-  pagLayer->draw(&recorder);
-  auto graphic = recorder.makeGraphic();
   return pagSurface->hitTest(renderCache, graphic, local.x, local.y);
 }
 
@@ -261,6 +261,18 @@ bool PAGSurface::prepare(RenderCache* cache, std::shared_ptr<Graphic> graphic) {
   return true;
 }
 
+int PAGSurface::warmUp(RenderCache* cache) {
+  auto context = lockContext();
+  if (!context) {
+    return -1;
+  }
+  cache->attachToContext(context, false);
+  auto count = cache->warmUpFilters();
+  cache->detachFromContext();
+  unlockContext();
+  return count;
+}
+
 bool PAGSurface::hitTest(RenderCache* cache, std::shared_ptr<Graphic> graphic, float x, float y) {
   if (cache == nullptr || graphic == nullptr) {
     return false;
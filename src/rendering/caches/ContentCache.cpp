@@ -96,7 +96,7 @@ Content* ContentCache::createCache(Frame layerFrame) {
     content->graphic = Graphic::MakeCompose(content->graphic, filterModifier);
   }
   if (_cacheEnabled) {
-    content->graphic = Picture::MakeFrom(getCacheID(), content->graphic);
+    content->graphic = Picture::MakeFrom(getCacheID(), content->graphic, _cacheFilters);
   }
   return content;
 }
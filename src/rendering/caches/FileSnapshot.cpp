@@ -0,0 +1,143 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FileSnapshot.h"
+#include "base/utils/HashUtil.h"
+#include "base/utils/StaticTimeRangesScope.h"
+#include "rendering/caches/DiskCache.h"
+#include "tgfx/core/Data.h"
+#include "tgfx/core/Task.h"
+
+namespace pag {
+// Increase the version whenever the layout of the snapshot or the way to compute its contents
+// changes, so that the outdated snapshots are ignored.
+static constexpr int64_t SnapshotVersion = 2;
+// The analysis results of smaller files are cheaper to compute than to read from the disk.
+static constexpr size_t MinSnapshotBytes = 32 * 1024;
+static constexpr int MinSnapshotLayers = 64;
+
+static std::shared_ptr<tgfx::Data> EncodeStaticTimeRanges(
+    uint64_t checksum, const std::vector<Composition*>& compositions) {
+  std::vector<int64_t> words = {SnapshotVersion, static_cast<int64_t>(checksum),
+                                static_cast<int64_t>(compositions.size())};
+  for (auto composition : compositions) {
+    auto& timeRanges = composition->staticTimeRanges;
+    words.push_back(static_cast<int64_t>(timeRanges.size()));
+    for (auto& range : timeRanges) {
+      words.push_back(range.start);
+      words.push_back(range.end);
+    }
+  }
+  return tgfx::Data::MakeWithCopy(words.data(), words.size() * sizeof(int64_t));
+}
+
+std::shared_ptr<File> FileSnapshot::LoadFile(const void* bytes, size_t length,
+                                             const std::string& filePath,
+                                             const std::string& password) {
+  if (bytes == nullptr || length < MinSnapshotBytes) {
+    return File::Load(bytes, length, filePath, password);
+  }
+  std::string key = "";
+  uint64_t checksum = 0;
+  // The bytes are only hashed once the file misses the cache of live files and gets decoded.
+  StaticTimeRangesScope scope([&]() {
+    key = MakeKey(Hash64(bytes, length), length);
+    checksum = Checksum64(bytes, length);
+    return ReadStaticTimeRanges(key, checksum);
+  });
+  auto file = File::Load(bytes, length, filePath, password);
+  if (file != nullptr && scope.decoded() && !scope.restored() &&
+      file->numLayers() >= MinSnapshotLayers) {
+    WriteStaticTimeRangesAsync(key, checksum, file->compositions);
+  }
+  return file;
+}
+
+std::string FileSnapshot::MakeKey(uint64_t hash, size_t length) {
+  if (length == 0) {
+    return "";
+  }
+  return "FileSnapshot/" + std::to_string(hash) + "_" + std::to_string(length);
+}
+
+std::vector<std::vector<TimeRange>> FileSnapshot::ReadStaticTimeRanges(const std::string& key,
+                                                                       uint64_t checksum) {
+  if (key.empty()) {
+    return {};
+  }
+  auto data = DiskCache::ReadFile(key);
+  if (data == nullptr || data->size() % sizeof(int64_t) != 0) {
+    return {};
+  }
+  auto words = static_cast<const int64_t*>(data->data());
+  auto count = data->size() / sizeof(int64_t);
+  size_t index = 0;
+  auto readWord = [&](int64_t* value) {
+    if (index >= count) {
+      return false;
+    }
+    *value = words[index++];
+    return true;
+  };
+  int64_t version = 0;
+  int64_t storedChecksum = 0;
+  int64_t numCompositions = 0;
+  if (!readWord(&version) || version != SnapshotVersion || !readWord(&storedChecksum) ||
+      storedChecksum != static_cast<int64_t>(checksum) || !readWord(&numCompositions) ||
+      numCompositions <= 0 || numCompositions > static_cast<int64_t>(count - index)) {
+    return {};
+  }
+  std::vector<std::vector<TimeRange>> result = {};
+  for (int64_t i = 0; i < numCompositions; i++) {
+    int64_t numRanges = 0;
+    if (!readWord(&numRanges) || numRanges < 0 ||
+        numRanges > static_cast<int64_t>(count - index) / 2) {
+      return {};
+    }
+    std::vector<TimeRange> timeRanges = {};
+    for (int64_t j = 0; j < numRanges; j++) {
+      TimeRange range = {};
+      readWord(&range.start);
+      readWord(&range.end);
+      timeRanges.push_back(range);
+    }
+    result.push_back(std::move(timeRanges));
+  }
+  if (index != count) {
+    return {};
+  }
+  return result;
+}
+
+void FileSnapshot::WriteStaticTimeRanges(const std::string& key, uint64_t checksum,
+                                         const std::vector<Composition*>& compositions) {
+  if (key.empty()) {
+    return;
+  }
+  DiskCache::WriteFile(key, EncodeStaticTimeRanges(checksum, compositions));
+}
+
+void FileSnapshot::WriteStaticTimeRangesAsync(const std::string& key, uint64_t checksum,
+                                              const std::vector<Composition*>& compositions) {
+  if (key.empty()) {
+    return;
+  }
+  auto data = EncodeStaticTimeRanges(checksum, compositions);
+  tgfx::Task::Run([key, data]() { DiskCache::WriteFile(key, data); });
+}
+}  // namespace pag
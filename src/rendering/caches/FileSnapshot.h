@@ -0,0 +1,69 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "pag/file.h"
+
+namespace pag {
+/**
+ * FileSnapshot persists the results of the analysis passes that run after a pag file is parsed,
+ * such as the static time ranges of every composition, into the disk cache. The snapshot is keyed
+ * by the content hash of the file bytes, so loading the same bytes again restores the results
+ * instead of visiting every layer and keyframe to compute them. A second checksum of the bytes is
+ * stored in the snapshot, so the bytes that share the key by a hash collision never read it.
+ */
+class FileSnapshot {
+ public:
+  /**
+   * Loads a pag file from the bytes like File::Load(), but restores the static time ranges from the
+   * snapshot of the bytes if the file is decoded, or writes the snapshot if it does not exist yet.
+   */
+  static std::shared_ptr<File> LoadFile(const void* bytes, size_t length,
+                                        const std::string& filePath,
+                                        const std::string& password = "");
+
+  /**
+   * Returns the snapshot key of the file bytes with the specified content hash and length.
+   */
+  static std::string MakeKey(uint64_t hash, size_t length);
+
+  /**
+   * Reads the static time ranges of every composition from the snapshot with the specified key.
+   * Returns an empty list if the snapshot does not exist, is malformed, or was written for the
+   * bytes with a different checksum. The caller is responsible for checking that the ranges fit
+   * the compositions of the file.
+   */
+  static std::vector<std::vector<TimeRange>> ReadStaticTimeRanges(const std::string& key,
+                                                                  uint64_t checksum);
+
+  /**
+   * Writes the static time ranges of the compositions into the snapshot with the specified key,
+   * along with the checksum of the file bytes.
+   */
+  static void WriteStaticTimeRanges(const std::string& key, uint64_t checksum,
+                                    const std::vector<Composition*>& compositions);
+
+  /**
+   * Copies the static time ranges of the compositions and writes them into the snapshot with the
+   * specified key on a background thread, so the caller does not wait for the disk.
+   */
+  static void WriteStaticTimeRangesAsync(const std::string& key, uint64_t checksum,
+                                         const std::vector<Composition*>& compositions);
+};
+}  // namespace pag
@@ -0,0 +1,218 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FrameProvider.h"
+#include "base/utils/Log.h"
+#include "base/utils/TGFXCast.h"
+
+namespace pag {
+// 正在显示的帧、等待上屏的帧和正在解码的帧各占一个缓冲区就够了。
+static constexpr size_t MAX_POOLED_BUFFERS = 3;
+
+FramePixels::FramePixels(const tgfx::ImageInfo& info) : _info(info), buffer(info.byteSize()) {
+}
+
+std::shared_ptr<FrameProvider> FrameProvider::Make(std::shared_ptr<PAGDecoder> decoder,
+                                                   ColorType colorType, AlphaType alphaType) {
+  if (decoder == nullptr || decoder->width() <= 0 || decoder->height() <= 0) {
+    return nullptr;
+  }
+  auto info = tgfx::ImageInfo::Make(decoder->width(), decoder->height(), ToTGFX(colorType),
+                                    ToTGFX(alphaType));
+  if (info.isEmpty()) {
+    return nullptr;
+  }
+  return std::shared_ptr<FrameProvider>(new FrameProvider(std::move(decoder), info));
+}
+
+FrameProvider::FrameProvider(std::shared_ptr<PAGDecoder> decoder, const tgfx::ImageInfo& info)
+    : decoder(std::move(decoder)), info(info) {
+}
+
+bool FrameProvider::cacheAllFramesInMemory() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _cacheAllFramesInMemory;
+}
+
+void FrameProvider::setCacheAllFramesInMemory(bool value) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (_cacheAllFramesInMemory == value) {
+    return;
+  }
+  _cacheAllFramesInMemory = value;
+  if (!value) {
+    clearMemoryCache();
+  }
+}
+
+size_t FrameProvider::memoryCacheSize() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return cacheSize;
+}
+
+std::shared_ptr<FramePixels> FrameProvider::readFrame(int index) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  checkDecoderChange();
+  if (index < 0 || index >= lastNumFrames) {
+    LOGE("FrameProvider::readFrame() The index is out of range!");
+    return nullptr;
+  }
+  // 同一个静止区间内的帧画面完全相同，统一用区间的起始帧作为缓存的 key。
+  auto key = GetTimeRangeContains(staticTimeRanges, index).start;
+  auto frame = obtainBuffer(key);
+  if (frame == nullptr) {
+    return nullptr;
+  }
+  if (frame->_frameIndex >= 0 &&
+      GetTimeRangeContains(staticTimeRanges, frame->_frameIndex).start == key) {
+    // 空闲的缓冲区里已经是同一帧的画面，无需重新解码。
+    frame->_frameIndex = index;
+    return frame;
+  }
+  frame->_frameIndex = -1;
+  if (_cacheAllFramesInMemory && readFromMemoryCache(key, frame.get())) {
+    frame->_frameIndex = index;
+    return frame;
+  }
+  if (!decoder->readFrame(index, frame->writablePixels(), info.rowBytes(),
+                          ToPAG(info.colorType()), ToPAG(info.alphaType()))) {
+    return nullptr;
+  }
+  frame->_frameIndex = index;
+  if (_cacheAllFramesInMemory) {
+    writeToMemoryCache(key, frame.get());
+  }
+  return frame;
+}
+
+std::shared_ptr<FramePixels> FrameProvider::obtainBuffer(Frame key) {
+  // 优先复用已经存有目标帧的空闲缓冲区，其次复用任意空闲的缓冲区。
+  std::shared_ptr<FramePixels> idleBuffer = nullptr;
+  for (auto& buffer : bufferPool) {
+    if (buffer.use_count() != 1) {
+      continue;
+    }
+    if (buffer->_frameIndex >= 0 &&
+        GetTimeRangeContains(staticTimeRanges, buffer->_frameIndex).start == key) {
+      return buffer;
+    }
+    if (idleBuffer == nullptr) {
+      idleBuffer = buffer;
+    }
+  }
+  if (idleBuffer != nullptr) {
+    return idleBuffer;
+  }
+  auto buffer = std::make_shared<FramePixels>(info);
+  if (buffer->buffer.isEmpty()) {
+    LOGE("FrameProvider::readFrame() Failed to allocate the pixel buffer!");
+    return nullptr;
+  }
+  if (bufferPool.size() < MAX_POOLED_BUFFERS) {
+    bufferPool.push_back(buffer);
+  }
+  return buffer;
+}
+
+void FrameProvider::checkDecoderChange() {
+  // numFrames() 内部会检查 PAGComposition 是否被修改过，并刷新解码器的静止区间。
+  auto numFrames = decoder->numFrames();
+  std::lock_guard<std::mutex> decoderLock(decoder->locker);
+  if (numFrames == lastNumFrames && decoder->lastContentVersion == lastContentVersion) {
+    return;
+  }
+  lastNumFrames = numFrames;
+  lastContentVersion = decoder->lastContentVersion;
+  staticTimeRanges = decoder->staticTimeRanges;
+  uniqueFrames = numFrames;
+  for (auto& timeRange : staticTimeRanges) {
+    uniqueFrames -= static_cast<int>(timeRange.duration() - 1);
+  }
+  clearMemoryCache();
+  for (auto& buffer : bufferPool) {
+    buffer->_frameIndex = -1;
+  }
+}
+
+void FrameProvider::clearMemoryCache() {
+  compressedFrames.clear();
+  cacheSize = 0;
+  scratchBuffer.reset();
+  encoder = nullptr;
+  lz4Decoder = nullptr;
+}
+
+bool FrameProvider::readFromMemoryCache(Frame key, FramePixels* frame) {
+  auto result = compressedFrames.find(key);
+  if (result == compressedFrames.end()) {
+    return false;
+  }
+  auto& data = result->second;
+  auto byteSize = info.byteSize();
+  // 压缩后没有变小的帧直接以原始像素存储。
+  if (data->size() == byteSize) {
+    memcpy(frame->writablePixels(), data->bytes(), byteSize);
+    return true;
+  }
+  if (lz4Decoder == nullptr) {
+    lz4Decoder = LZ4Decoder::Make();
+  }
+  auto decodedLength = lz4Decoder->decode(reinterpret_cast<uint8_t*>(frame->writablePixels()),
+                                          byteSize, data->bytes(), data->size());
+  if (decodedLength != byteSize) {
+    LOGE("FrameProvider::readFrame() Failed to decode the frame %lld from memory!", key);
+    cacheSize -= data->size();
+    compressedFrames.erase(result);
+    return false;
+  }
+  return true;
+}
+
+void FrameProvider::writeToMemoryCache(Frame key, const FramePixels* frame) {
+  if (compressedFrames.count(key) > 0) {
+    return;
+  }
+  auto byteSize = info.byteSize();
+  if (scratchBuffer.isEmpty()) {
+    scratchBuffer.alloc(LZ4Encoder::GetMaxOutputSize(byteSize));
+    if (scratchBuffer.isEmpty()) {
+      return;
+    }
+  }
+  if (encoder == nullptr) {
+    encoder = LZ4Encoder::Make();
+  }
+  auto pixels = reinterpret_cast<const uint8_t*>(frame->pixels());
+  auto encodedLength =
+      encoder->encode(scratchBuffer.bytes(), scratchBuffer.size(), pixels, byteSize);
+  auto compressed = encodedLength > 0 && encodedLength < byteSize;
+  auto length = compressed ? encodedLength : byteSize;
+  auto data = std::make_unique<tgfx::Buffer>(length);
+  if (data->isEmpty()) {
+    return;
+  }
+  memcpy(data->bytes(), compressed ? scratchBuffer.bytes() : pixels, length);
+  cacheSize += length;
+  compressedFrames[key] = std::move(data);
+  if (compressedFrames.size() >= static_cast<size_t>(uniqueFrames)) {
+    // 所有帧都已缓存，不会再有压缩操作，提前释放压缩用的临时内存。
+    scratchBuffer.reset();
+    encoder = nullptr;
+  }
+}
+}  // namespace pag
@@ -0,0 +1,133 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "pag/pag.h"
+#include "rendering/utils/LZ4Decoder.h"
+#include "rendering/utils/LZ4Encoder.h"
+#include "tgfx/core/Buffer.h"
+#include "tgfx/core/ImageInfo.h"
+
+namespace pag {
+/**
+ * FramePixels holds the pixels of one decoded frame. The buffer is handed back to its
+ * FrameProvider for reuse once all references to it are released.
+ */
+class FramePixels {
+ public:
+  explicit FramePixels(const tgfx::ImageInfo& info);
+
+  const tgfx::ImageInfo& info() const {
+    return _info;
+  }
+
+  const void* pixels() const {
+    return buffer.bytes();
+  }
+
+  void* writablePixels() {
+    return buffer.bytes();
+  }
+
+  /**
+   * Returns the index of the frame currently stored in the buffer, or -1 if it is empty.
+   */
+  int frameIndex() const {
+    return _frameIndex;
+  }
+
+ private:
+  tgfx::ImageInfo _info = {};
+  tgfx::Buffer buffer = {};
+  int _frameIndex = -1;
+
+  friend class FrameProvider;
+};
+
+/**
+ * FrameProvider reads image frames from a PAGDecoder for image-view style playback. Instead of
+ * allocating a new bitmap for every frame, it recycles a small pool of pixel buffers. It can also
+ * keep all decoded frames in memory in LZ4-compressed form, where every static time range of the
+ * decoder only stores one frame.
+ */
+class FrameProvider {
+ public:
+  /**
+   * Creates a FrameProvider with the specified PAGDecoder. Returns nullptr if the decoder is
+   * nullptr or the decoded frames are empty.
+   */
+  static std::shared_ptr<FrameProvider> Make(std::shared_ptr<PAGDecoder> decoder,
+                                             ColorType colorType = ColorType::RGBA_8888,
+                                             AlphaType alphaType = AlphaType::Premultiplied);
+
+  std::shared_ptr<PAGDecoder> getDecoder() const {
+    return decoder;
+  }
+
+  /**
+   * Returns true if all decoded frames are kept in memory in compressed form. The default value is
+   * false.
+   */
+  bool cacheAllFramesInMemory();
+
+  /**
+   * Sets whether to keep all decoded frames in memory. Disabling it releases the existing cache.
+   */
+  void setCacheAllFramesInMemory(bool value);
+
+  /**
+   * Returns the total size in bytes of the compressed frames kept in memory.
+   */
+  size_t memoryCacheSize();
+
+  /**
+   * Returns the pixels of the frame at the given index, or nullptr if failed. The returned buffer
+   * comes from the internal pool, so the caller should release it as soon as the frame is no
+   * longer displayed.
+   */
+  std::shared_ptr<FramePixels> readFrame(int index);
+
+ private:
+  std::mutex locker = {};
+  std::shared_ptr<PAGDecoder> decoder = nullptr;
+  tgfx::ImageInfo info = {};
+  bool _cacheAllFramesInMemory = false;
+  std::vector<std::shared_ptr<FramePixels>> bufferPool = {};
+  std::unordered_map<Frame, std::unique_ptr<tgfx::Buffer>> compressedFrames = {};
+  std::vector<TimeRange> staticTimeRanges = {};
+  size_t cacheSize = 0;
+  int lastNumFrames = 0;
+  int uniqueFrames = 0;
+  uint32_t lastContentVersion = 0;
+  tgfx::Buffer scratchBuffer = {};
+  std::unique_ptr<LZ4Encoder> encoder = nullptr;
+  std::unique_ptr<LZ4Decoder> lz4Decoder = nullptr;
+
+  FrameProvider(std::shared_ptr<PAGDecoder> decoder, const tgfx::ImageInfo& info);
+
+  std::shared_ptr<FramePixels> obtainBuffer(Frame key);
+  void checkDecoderChange();
+  void clearMemoryCache();
+  bool readFromMemoryCache(Frame key, FramePixels* frame);
+  void writeToMemoryCache(Frame key, const FramePixels* frame);
+};
+}  // namespace pag
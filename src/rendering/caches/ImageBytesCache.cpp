@@ -19,6 +19,30 @@
 #include "ImageBytesCache.h"
 
 namespace pag {
+static void ReleaseSharedBytes(const void*, void* context) {
+  delete static_cast<std::shared_ptr<ByteData>*>(context);
+}
+
+/**
+ * Shares the encoded bytes decoded from a PAG file with the returned tgfx::Data instead of copying
+ * them. The image may outlive the File (e.g. held by an asynchronous decoding task), so the bytes
+ * are released only after both the ImageBytes and the tgfx::Data are released. The fileBytes is
+ * never reassigned here, it may be read by other threads without holding the locker.
+ */
+static std::shared_ptr<tgfx::Data> MakeSharedData(ImageBytes* imageBytes) {
+  auto fileBytes = imageBytes->fileBytes;
+  if (fileBytes == nullptr) {
+    return nullptr;
+  }
+  auto& sharedBytes = imageBytes->sharedBytes;
+  if (sharedBytes == nullptr || sharedBytes->data() != fileBytes->data() ||
+      sharedBytes->length() != fileBytes->length()) {
+    // The fileBytes has been replaced by the user, it has no shared owner.
+    return tgfx::Data::MakeWithCopy(fileBytes->data(), fileBytes->length());
+  }
+  return tgfx::Data::MakeAdopted(sharedBytes->data(), sharedBytes->length(), ReleaseSharedBytes,
+                                 new std::shared_ptr<ByteData>(sharedBytes));
+}
 
 ImageBytesCache* ImageBytesCache::Get(ImageBytes* imageBytes) {
   std::lock_guard<std::mutex> autoLock(imageBytes->locker);
@@ -26,9 +50,7 @@ ImageBytesCache* ImageBytesCache::Get(ImageBytes* imageBytes) {
     return static_cast<ImageBytesCache*>(imageBytes->cache);
   }
   auto cache = new ImageBytesCache();
-  auto fileBytes =
-      tgfx::Data::MakeWithCopy(imageBytes->fileBytes->data(), imageBytes->fileBytes->length());
-  auto image = tgfx::Image::MakeFromEncoded(std::move(fileBytes));
+  auto image = tgfx::Image::MakeFromEncoded(MakeSharedData(imageBytes));
   auto picture = Picture::MakeFrom(imageBytes->uniqueID, image);
   auto matrix = tgfx::Matrix::MakeScale(1 / imageBytes->scaleFactor);
   matrix.postTranslate(static_cast<float>(-imageBytes->anchorX),
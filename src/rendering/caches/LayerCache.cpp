@@ -102,6 +102,10 @@ std::shared_ptr<Modifier> LayerCache::getFeatherMask(Frame contentFrame) {
   return Modifier::MakeMask(featherMaskContent->graphic, false, false);
 }
 
+ID LayerCache::getFeatherMaskID() const {
+  return featherMaskCache ? featherMaskCache->uniqueID() : 0;
+}
+
 Content* LayerCache::getContent(Frame contentFrame) {
   return contentCache->getCache(contentFrame);
 }
@@ -206,6 +210,17 @@ std::vector<TimeRange> LayerCache::getFilterStaticTimeRanges() {
   for (auto& effect : layer->effects) {
     effect->excludeVaryingRanges(&timeRanges);
   }
+  if (layer->transform3D != nullptr && layer->containingComposition != nullptr) {
+    // 3D 图层的投影还取决于所在合成里的摄像机。
+    for (auto child : layer->containingComposition->layers) {
+      if (child->type() != LayerType::Camera) {
+        continue;
+      }
+      child->excludeVaryingRanges(&timeRanges);
+      SplitTimeRangesAt(&timeRanges, child->startTime);
+      SplitTimeRangesAt(&timeRanges, child->startTime + child->duration);
+    }
+  }
   return OffsetTimeRanges(timeRanges, -layer->startTime);
 }
 }  // namespace pag
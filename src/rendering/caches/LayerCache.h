@@ -37,6 +37,11 @@ class LayerCache : public Cache {
 
   std::shared_ptr<Modifier> getFeatherMask(Frame contentFrame);
 
+  /**
+   * Returns the asset id of the feather mask snapshots, or 0 if the layer has no feather masks.
+   */
+  ID getFeatherMaskID() const;
+
   Content* getContent(Frame contentFrame);
 
   Layer* getLayer() const;
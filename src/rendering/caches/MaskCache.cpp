@@ -17,7 +17,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "MaskCache.h"
+#include "base/utils/UniqueID.h"
 #include "rendering/graphics/FeatherMask.h"
+#include "rendering/graphics/Picture.h"
 #include "rendering/renderers/MaskRenderer.h"
 
 namespace pag {
@@ -37,7 +39,8 @@ tgfx::Path* MaskCache::createCache(Frame layerFrame) {
 }
 
 FeatherMaskCache::FeatherMaskCache(Layer* layer)
-    : FrameCache<GraphicContent>(layer->startTime, layer->duration), layer(layer) {
+    : FrameCache<GraphicContent>(layer->startTime, layer->duration), layer(layer),
+      _uniqueID(UniqueID::Next()) {
   std::vector<TimeRange> timeRanges = {layer->visibleRange()};
   for (auto& mask : layer->masks) {
     mask->excludeVaryingRanges(&timeRanges);
@@ -47,6 +50,11 @@ FeatherMaskCache::FeatherMaskCache(Layer* layer)
 
 GraphicContent* FeatherMaskCache::createCache(Frame layerFrame) {
   auto featherMask = FeatherMask::MakeFrom(layer->masks, layerFrame);
+  if (featherMask != nullptr) {
+    // 羽化遮罩的路径扩展和模糊代价很高，在同一个静态区间内只光栅化一次，之后直接复用快照纹理。
+    // 快照以 FeatherMaskCache 的 ID 作为缓存的 key，缩放值变化或进入新的区间时才会重新生成。
+    featherMask = Picture::MakeFrom(_uniqueID, featherMask);
+  }
   return new GraphicContent(featherMask);
 }
 }  // namespace pag
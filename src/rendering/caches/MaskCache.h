@@ -38,10 +38,18 @@ class FeatherMaskCache : public FrameCache<GraphicContent> {
  public:
   explicit FeatherMaskCache(Layer* layer);
 
+  /**
+   * Returns a globally unique id for the snapshots of the feather masks.
+   */
+  ID uniqueID() const {
+    return _uniqueID;
+  }
+
  protected:
   GraphicContent* createCache(Frame layerFrame) override;
 
  private:
   Layer* layer = nullptr;
+  ID _uniqueID = 0;
 };
 }  // namespace pag
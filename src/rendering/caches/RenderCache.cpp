@@ -17,7 +17,10 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "RenderCache.h"
+#include <algorithm>
 #include <functional>
+#include "base/utils/MatrixUtil.h"
+#include "base/utils/TGFXCast.h"
 #include "base/utils/TimeUtil.h"
 #include "base/utils/UniqueID.h"
 #include "rendering/caches/ImageContentCache.h"
@@ -27,6 +30,7 @@
 #include "rendering/renderers/FilterRenderer.h"
 #include "rendering/sequences/SequenceImageProxy.h"
 #include "rendering/sequences/SequenceInfo.h"
+#include "rendering/utils/MemoryCalculator.h"
 #include "tgfx/core/Clock.h"
 
 namespace pag {
@@ -37,6 +41,10 @@ static constexpr int PURGEABLE_EXPIRED_FRAME = 10;
 static constexpr float SCALE_FACTOR_PRECISION = 0.001f;
 static constexpr float MIPMAP_ENABLED_THRESHOLD = -1.0f;      // 临时关闭 mipmap
 static constexpr int64_t DECODING_VISIBLE_DISTANCE = 500000;  // 提前 500ms 开始解码。
+static constexpr float MIN_FILTER_QUALITY = 0.25f;
+static constexpr float FILTER_QUALITY_DECREASE_FACTOR = 0.75f;
+static constexpr float FILTER_QUALITY_INCREASE_STEP = 0.125f;
+static constexpr int FILTER_QUALITY_HEADROOM_FRAMES = 30;  // 连续 30 帧有富余才提升质量。
 
 RenderCache::RenderCache(PAGStage* stage) : _uniqueID(UniqueID::Next()), stage(stage) {
 }
@@ -45,6 +53,10 @@ RenderCache::~RenderCache() {
   releaseAll();
 }
 
+float RenderCache::getAssetMaxScale(ID assetID) {
+  return stage->getAssetMaxScale(assetID);
+}
+
 uint32_t RenderCache::getContentVersion() const {
   return stage->getContentVersion();
 }
@@ -61,6 +73,42 @@ void RenderCache::setVideoEnabled(bool value) {
   clearAllSequenceCaches();
 }
 
+void RenderCache::setAdaptiveQuality(bool value) {
+  filterQuality.adaptive = value;
+  setFilterQualityLevel(1.0f);
+  headroomFrames = 0;
+}
+
+void RenderCache::setFilterQualityLevel(float level) {
+  if (filterQuality.level == level) {
+    return;
+  }
+  filterQuality.level = level;
+  filterQualityVersion++;
+  // 带滤镜的图层录制内容依赖于当前的滤镜质量，质量变化后需要重新录制。
+  stage->invalidateFilterGraphics();
+}
+
+void RenderCache::updateFilterQuality(int64_t renderingTime, int64_t frameInterval) {
+  if (!filterQuality.adaptive || frameInterval <= 0) {
+    return;
+  }
+  if (renderingTime > frameInterval) {
+    // 错过了帧截止时间，立即降低滤镜质量。
+    setFilterQualityLevel(
+        std::max(MIN_FILTER_QUALITY, filterQuality.level * FILTER_QUALITY_DECREASE_FACTOR));
+    headroomFrames = 0;
+  } else if (renderingTime < frameInterval / 2 && filterQuality.level < 1.0f) {
+    // 耗时不到一半的帧间隔时认为有富余，持续一段时间后逐步恢复质量，避免来回抖动。
+    if (++headroomFrames >= FILTER_QUALITY_HEADROOM_FRAMES) {
+      setFilterQualityLevel(std::min(1.0f, filterQuality.level + FILTER_QUALITY_INCREASE_STEP));
+      headroomFrames = 0;
+    }
+  } else {
+    headroomFrames = 0;
+  }
+}
+
 bool RenderCache::initFilter(Filter* filter) {
   tgfx::Clock clock = {};
   auto result = filter->initialize(getContext());
@@ -86,6 +134,42 @@ void RenderCache::prepareLayers() {
   }
 }
 
+int RenderCache::warmUpFilters() {
+  if (context == nullptr) {
+    return 0;
+  }
+  return warmUpLayerFilters(stage);
+}
+
+int RenderCache::warmUpLayerFilters(PAGLayer* pagLayer) {
+  int count = 0;
+  auto layer = pagLayer->layer;
+  for (auto& effect : layer->effects) {
+    count += getFilterCache(effect) != nullptr;
+  }
+  if (!layer->layerStyles.empty() && getLayerStylesFilter(layer) != nullptr) {
+    count++;
+    for (auto& layerStyle : layer->layerStyles) {
+      count += getFilterCache(layerStyle) != nullptr;
+    }
+  }
+  if (layer->motionBlur && !layer->transform3D) {
+    count += getMotionBlurFilter() != nullptr;
+  }
+  if (layer->transform3D) {
+    count += getTransform3DFilter() != nullptr;
+  }
+  if (pagLayer->_trackMatteLayer != nullptr) {
+    count += warmUpLayerFilters(pagLayer->_trackMatteLayer.get());
+  }
+  if (pagLayer->layerType() == LayerType::PreCompose) {
+    for (auto& childLayer : static_cast<PAGComposition*>(pagLayer)->layers) {
+      count += warmUpLayerFilters(childLayer.get());
+    }
+  }
+  return count;
+}
+
 void RenderCache::preparePreComposeLayer(PreComposeLayer* layer) {
   auto composition = layer->composition;
   if (composition->type() != CompositionType::Video &&
@@ -144,6 +228,62 @@ void RenderCache::clearExpiredSequences() {
   }
 }
 
+void RenderCache::updateMemoryForecast() {
+  currentForecastMemory = 0;
+  upcomingForecastMemory = 0;
+  addMemoryForecast(stage);
+}
+
+void RenderCache::addMemoryForecast(PAGLayer* pagLayer) {
+  if (pagLayer->layerType() != LayerType::PreCompose) {
+    return;
+  }
+  auto pagComposition = static_cast<PAGComposition*>(pagLayer);
+  if (!pagComposition->isPAGFile()) {
+    for (auto& childLayer : pagComposition->layers) {
+      addMemoryForecast(childLayer.get());
+    }
+    return;
+  }
+  // 首次查询时在后台计算，不阻塞渲染线程，计算完成前不做预测。
+  auto memories = MemoryCalculator::RequestGraphicsMemoriesPerFrame(pagComposition->file);
+  if (memories == nullptr || memories->empty()) {
+    return;
+  }
+  // 预测值是按文件原始尺寸计算的，这里换算到文件在舞台上的实际尺寸。
+  auto matrixScale = GetScaleFactor(ToTGFX(pagComposition->layerMatrix));
+  auto scale = pagComposition->_parent != nullptr
+                   ? PAGStage::GetLayerScaleFactor(pagComposition->_parent, matrixScale).first
+                   : std::max(matrixScale.x, matrixScale.y);
+  scale *= stage->cacheScale();
+  auto factor = std::min(scale * scale, 1.0f);
+  auto duration = static_cast<Frame>(memories->size());
+  auto currentFrame = pagComposition->contentFrame;
+  if (currentFrame >= 0 && currentFrame < duration) {
+    currentForecastMemory += static_cast<int64_t>((*memories)[currentFrame] * factor);
+  }
+  // 与 prepareLayers() 的预测范围保持一致，按循环播放处理。
+  auto lookaheadFrames = TimeToFrame(DECODING_VISIBLE_DISTANCE, pagComposition->frameRateInternal());
+  int64_t peakMemory = 0;
+  for (Frame i = 0; i <= lookaheadFrames && i < duration; i++) {
+    auto frame = (currentFrame + i) % duration;
+    if (frame >= 0) {
+      peakMemory = std::max(peakMemory, (*memories)[frame]);
+    }
+  }
+  upcomingForecastMemory += static_cast<int64_t>(peakMemory * factor);
+}
+
+int64_t RenderCache::purgeableMemoryLimit() const {
+  // 即将到来的帧本身就需要的显存不应被当作可清理的冗余缓存。
+  return std::max(static_cast<int64_t>(PURGEABLE_GRAPHICS_MEMORY), upcomingForecastMemory);
+}
+
+int64_t RenderCache::forecastMemoryGrowth() const {
+  // 显存峰值即将到来时，提前为其腾出空间。
+  return std::max(static_cast<int64_t>(0), upcomingForecastMemory - currentForecastMemory);
+}
+
 bool RenderCache::snapshotEnabled() const {
   return _snapshotEnabled;
 }
@@ -209,6 +349,7 @@ void RenderCache::detachFromContext() {
   }
   prepareNextFrame();
   recordPerformance();
+  updateMemoryForecast();
   clearExpiredSequences();
   clearExpiredDecodedImages();
   clearExpiredSnapshots();
@@ -216,10 +357,11 @@ void RenderCache::detachFromContext() {
     // Always purge recycled resources that haven't been used in 1 frame.
     context->purgeResourcesNotUsedSince(timestamps.back(), true);
   }
-  if (context->memoryUsage() + graphicsMemory > PURGEABLE_GRAPHICS_MEMORY &&
-      timestamps.size() == PURGEABLE_EXPIRED_FRAME) {
+  auto totalMemory =
+      static_cast<int64_t>(context->memoryUsage() + graphicsMemory) + forecastMemoryGrowth();
+  if (totalMemory > purgeableMemoryLimit() && timestamps.size() == PURGEABLE_EXPIRED_FRAME) {
     // Purge all types of resources that haven't been used in 10 frames when the total memory usage
-    // is over 20M.
+    // plus the growth of the upcoming frames is over the limit.
     context->purgeResourcesNotUsedSince(timestamps.front(), false);
   }
   timestamps.push(std::chrono::steady_clock::now());
@@ -247,8 +389,10 @@ Snapshot* RenderCache::getSnapshot(const Picture* picture) {
   usedAssets.insert(picture->assetID);
   auto maxScaleFactor = stage->getAssetMaxScale(picture->assetID);
   auto scaleFactor = picture->getScaleFactor(maxScaleFactor);
+  auto qualityVersion = picture->dependsOnFilterQuality() ? filterQualityVersion : 0;
   auto snapshot = getSnapshot(picture->assetID);
   if (snapshot && (snapshot->makerKey != picture->uniqueKey ||
+                   snapshot->qualityVersion != qualityVersion ||
                    fabsf(snapshot->scaleFactor() - scaleFactor) > SCALE_FACTOR_PRECISION)) {
     removeSnapshot(picture->assetID);
     snapshot = nullptr;
@@ -270,6 +414,7 @@ Snapshot* RenderCache::getSnapshot(const Picture* picture) {
   snapshot = newSnapshot.release();
   snapshot->assetID = picture->assetID;
   snapshot->makerKey = picture->uniqueKey;
+  snapshot->qualityVersion = qualityVersion;
   graphicsMemory += snapshot->memoryUsage();
   snapshotLRU.push_front(snapshot);
   snapshotPositions[snapshot] = snapshotLRU.begin();
@@ -363,6 +508,8 @@ void RenderCache::clearAllSnapshots() {
 void RenderCache::clearExpiredSnapshots() {
   std::vector<Snapshot*> expiredSnapshots;
   size_t releaseMemory = 0;
+  auto memoryLimit = purgeableMemoryLimit();
+  auto memoryGrowth = forecastMemoryGrowth();
   for (auto snapshotIter = snapshotLRU.rbegin(); snapshotIter != snapshotLRU.rend();
        snapshotIter++) {
     auto* snapshot = *snapshotIter;
@@ -373,8 +520,8 @@ void RenderCache::clearExpiredSnapshots() {
     }
     snapshot->idleFrames++;
     if (snapshot->idleFrames < PURGEABLE_EXPIRED_FRAME &&
-        graphicsMemory - releaseMemory < PURGEABLE_GRAPHICS_MEMORY) {
-      // 总显存占用未超过20M且所有缓存均未超过10帧未使用，跳过清理。
+        static_cast<int64_t>(graphicsMemory - releaseMemory) + memoryGrowth < memoryLimit) {
+      // 总显存占用加上即将到来的增长未超过上限且所有缓存均未超过10帧未使用，跳过清理。
       continue;
     }
     releaseMemory += snapshot->memoryUsage();
@@ -595,6 +742,9 @@ LayerFilter* RenderCache::getLayerFilterCache(ID uniqueID,
   } else {
     filter = static_cast<LayerFilter*>(result->second);
   }
+  if (filter != nullptr) {
+    filter->setQuality(filterQuality);
+  }
   return filter;
 }
 
@@ -613,6 +763,9 @@ MotionBlurFilter* RenderCache::getMotionBlurFilter() {
       motionBlurFilter = nullptr;
     }
   }
+  if (motionBlurFilter != nullptr) {
+    motionBlurFilter->setQuality(filterQuality);
+  }
   return motionBlurFilter;
 }
 
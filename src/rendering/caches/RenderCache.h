@@ -77,6 +77,13 @@ class RenderCache : public Performance {
    */
   void prepareLayers();
 
+  /**
+   * Creates and compiles the filters of all effects, layer styles and motion blurs in the stage in
+   * advance, so that the shader compilation doesn't stall a frame in the middle of the animation.
+   * Returns the number of filters that are ready to use.
+   */
+  int warmUpFilters();
+
   /**
    * If set to false, the getSnapshot() always returns nullptr. The default value is true.
    */
@@ -110,6 +117,25 @@ class RenderCache : public Performance {
     _useDiskCache = value;
   }
 
+  /**
+   * If set to true, filters adapt their quality to the measured rendering time. The default value
+   * is false.
+   */
+  bool adaptiveQuality() const {
+    return filterQuality.adaptive;
+  }
+
+  /**
+   * Set the value of adaptiveQuality property.
+   */
+  void setAdaptiveQuality(bool value);
+
+  /**
+   * Lowers the filter quality if the last frame took longer than the frame interval, and restores
+   * it gradually when rendering keeps finishing well ahead of the deadline.
+   */
+  void updateFilterQuality(int64_t renderingTime, int64_t frameInterval);
+
   /**
    * Returns a snapshot cache of specified asset id. Returns null if there is no associated cache
    * available. This is a read-only query which is used usually during hit testing.
@@ -142,6 +168,11 @@ class RenderCache : public Performance {
    */
   std::shared_ptr<tgfx::Image> getAssetImage(ID assetID, const ImageProxy* proxy);
 
+  /**
+   * Returns the max scale factor of the specified asset drawn on the stage.
+   */
+  float getAssetMaxScale(ID assetID);
+
   uint32_t getContentVersion() const;
 
   bool videoEnabled() const;
@@ -184,6 +215,13 @@ class RenderCache : public Performance {
   bool _videoEnabled = true;
   bool _snapshotEnabled = true;
   bool _useDiskCache = false;
+  FilterQuality filterQuality = {};
+  // Increases every time the filter quality level changes, the snapshots of content rendered by
+  // filters are made again once it changes.
+  uint32_t filterQualityVersion = 0;
+  int headroomFrames = 0;
+  int64_t currentForecastMemory = 0;
+  int64_t upcomingForecastMemory = 0;
   std::unordered_set<ID> usedAssets = {};
   std::unordered_map<ID, Snapshot*> snapshotCaches = {};
   std::list<Snapshot*> snapshotLRU = {};
@@ -197,6 +235,13 @@ class RenderCache : public Performance {
   MotionBlurFilter* motionBlurFilter = nullptr;
   Filter* transform3DFilter = nullptr;
 
+  // memory forecasts:
+  void updateMemoryForecast();
+  void addMemoryForecast(PAGLayer* pagLayer);
+  void setFilterQualityLevel(float level);
+  int64_t purgeableMemoryLimit() const;
+  int64_t forecastMemoryGrowth() const;
+
   // decoded image caches:
   void clearExpiredDecodedImages();
 
@@ -229,6 +274,7 @@ class RenderCache : public Performance {
   void preparePreComposeLayer(PreComposeLayer* layer);
   void prepareImageLayer(PAGImageLayer* layer);
   void prepareNextFrame();
+  int warmUpLayerFilters(PAGLayer* pagLayer);
   std::shared_ptr<tgfx::Image> getAssetImageInternal(ID assetID, const ImageProxy* proxy);
   void recordPerformance();
 
@@ -117,13 +117,21 @@ ID TextContentCache::getCacheID() const {
 }
 
 static std::vector<std::vector<GlyphHandle>> CopyLines(
-    const std::shared_ptr<TextBlock>& textBlock) {
+    const std::shared_ptr<TextBlock>& textBlock,
+    const std::vector<GlyphTransform>* transforms = nullptr) {
   std::vector<std::vector<GlyphHandle>> glyphLines;
+  size_t index = 0;
   for (const auto& line : textBlock->lines()) {
     std::vector<GlyphHandle> glyphLine;
     glyphLine.reserve(line.size());
     for (const auto& glyph : line) {
-      glyphLine.emplace_back(std::make_shared<Glyph>(*glyph));
+      auto newGlyph = std::make_shared<Glyph>(*glyph);
+      if (transforms != nullptr) {
+        auto& transform = (*transforms)[index++];
+        newGlyph->setMatrix(transform.matrix);
+        newGlyph->setAlpha(transform.alpha);
+      }
+      glyphLine.emplace_back(std::move(newGlyph));
     }
     glyphLines.emplace_back(glyphLine);
   }
@@ -155,10 +163,11 @@ GraphicContent* TextContentCache::createContent(Frame layerFrame) const {
     }
     block = iter->second;
   }
-  auto glyphLines = CopyLines(block);
+  std::vector<std::vector<GlyphHandle>> glyphLines = {};
   bool toCalculateBounds = false;
   auto textPathRender = TextPathRender::MakeFrom(textDocument, pathOption);
   if (textPathRender != nullptr) {
+    glyphLines = CopyLines(block);
     toCalculateBounds = true;
     // 强制对齐会导致重新排版
     textPathRender->applyForceAlignmentToGlyphs(glyphLines, layerFrame);
@@ -169,8 +178,12 @@ GraphicContent* TextContentCache::createContent(Frame layerFrame) const {
                                         layerFrame);
     textPathRender->applyToGlyphs(glyphLines, layerFrame);
   } else {
-    toCalculateBounds = TextAnimatorRenderer::ApplyToGlyphs(
-        glyphLines, animators, textDocument->justification, layerFrame);
+    // 排版结果在 TextBlock 里按 TextDocument 缓存，每帧只重新计算文本动画作用后的矩阵和透明度，
+    // 没有文本动画时字符不会被修改，直接复用排版结果。
+    std::vector<GlyphTransform> transforms = {};
+    toCalculateBounds = TextAnimatorRenderer::ComputeGlyphTransforms(
+        block->lines(), animators, textDocument->justification, layerFrame, &transforms);
+    glyphLines = toCalculateBounds ? CopyLines(block, &transforms) : block->lines();
   }
 
   std::vector<std::shared_ptr<Graphic>> contents = {};
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "TransformCache.h"
+#include "base/utils/TGFXCast.h"
 #include "rendering/renderers/TransformRenderer.h"
 
 namespace pag {
@@ -46,6 +47,10 @@ TransformCache::TransformCache(Layer* layer)
 
 Transform* TransformCache::createCache(Frame layerFrame) {
   auto transform = new Transform();
+  if (layer->transform3D != nullptr) {
+    // 3D 图层的位置由 Transform3DFilter 投影，这里只需要透明度。
+    transform->alpha = ToAlpha(layer->transform3D->opacity->getValueAt(layerFrame));
+  }
   if (layer->transform == nullptr) {
     return transform;
   }
@@ -17,12 +17,15 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "BitmapDrawable.h"
-#include "tgfx/gpu/opengl/GLDevice.h"
+#include "rendering/utils/GLDevicePool.h"
 
 namespace pag {
 std::shared_ptr<BitmapDrawable> BitmapDrawable::Make(int width, int height) {
-  auto device = tgfx::GLDevice::MakeWithFallback();
-  if (device == nullptr || width <= 0 || height <= 0) {
+  if (width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  auto device = GLDevicePool::Lease();
+  if (device == nullptr) {
     return nullptr;
   }
   return std::shared_ptr<BitmapDrawable>(new BitmapDrawable(width, height, std::move(device)));
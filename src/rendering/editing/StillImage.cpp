@@ -21,20 +21,28 @@
 #include "base/utils/UniqueID.h"
 #include "pag/pag.h"
 #include "rendering/caches/RenderCache.h"
+#include "rendering/graphics/CodecImageProxy.h"
 #include "rendering/graphics/Graphic.h"
 #include "rendering/graphics/Picture.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 
 namespace pag {
 std::shared_ptr<PAGImage> PAGImage::FromPath(const std::string& filePath) {
-  auto image = tgfx::Image::MakeFromFile(filePath);
-  return StillImage::MakeFrom(std::move(image));
+  auto pagImage = StillImage::MakeFrom(tgfx::ImageCodec::MakeFrom(filePath));
+  if (pagImage != nullptr) {
+    return pagImage;
+  }
+  // The orientation is applied by the image itself if the pixels of the codec need to be rotated.
+  return StillImage::MakeFrom(tgfx::Image::MakeFromFile(filePath));
 }
 
 std::shared_ptr<PAGImage> PAGImage::FromBytes(const void* bytes, size_t length) {
   auto fileBytes = tgfx::Data::MakeWithCopy(bytes, length);
-  auto image = tgfx::Image::MakeFromEncoded(std::move(fileBytes));
-  return StillImage::MakeFrom(std::move(image));
+  auto pagImage = StillImage::MakeFrom(tgfx::ImageCodec::MakeFrom(fileBytes));
+  if (pagImage != nullptr) {
+    return pagImage;
+  }
+  return StillImage::MakeFrom(tgfx::Image::MakeFromEncoded(fileBytes));
 }
 
 std::shared_ptr<PAGImage> PAGImage::FromPixels(const void* pixels, int width, int height,
@@ -60,6 +68,25 @@ std::shared_ptr<StillImage> StillImage::MakeFrom(std::shared_ptr<tgfx::Image> im
   return pagImage;
 }
 
+std::shared_ptr<StillImage> StillImage::MakeFrom(std::shared_ptr<tgfx::ImageCodec> codec) {
+  if (codec == nullptr || codec->orientation() != tgfx::Orientation::TopLeft) {
+    return nullptr;
+  }
+  auto image = tgfx::Image::MakeFrom(codec);
+  if (image == nullptr) {
+    return nullptr;
+  }
+  auto pagImage = std::shared_ptr<StillImage>(new StillImage(image->width(), image->height()));
+  auto proxy = std::make_shared<CodecImageProxy>(pagImage->uniqueID(), std::move(codec),
+                                                 std::move(image));
+  auto picture = Picture::MakeFrom(pagImage->uniqueID(), std::move(proxy));
+  if (!picture) {
+    return nullptr;
+  }
+  pagImage->graphic = picture;
+  return pagImage;
+}
+
 std::shared_ptr<PAGImage> PAGImage::FromTexture(const BackendTexture& texture, ImageOrigin origin) {
   auto context = tgfx::GLDevice::CurrentNativeHandle();
   if (context == nullptr) {
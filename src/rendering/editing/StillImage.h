@@ -28,6 +28,13 @@ class StillImage : public PAGImage {
  public:
   static std::shared_ptr<StillImage> MakeFrom(std::shared_ptr<tgfx::Image> image);
 
+  /**
+   * Creates a StillImage from an image codec, which is decoded at the largest size it is actually
+   * displayed. The image and the scaled decoding share the codec. Returns nullptr if the codec is
+   * nullptr or its pixels need to be rotated.
+   */
+  static std::shared_ptr<StillImage> MakeFrom(std::shared_ptr<tgfx::ImageCodec> codec);
+
  protected:
   std::shared_ptr<Graphic> getGraphic(int64_t) const override {
     return graphic;
@@ -69,14 +69,23 @@ static bool PointIsBetween(const tgfx::Point& point, const tgfx::Point& start,
   return minX <= point.x && point.x <= maxX && minY <= point.y && point.y <= maxY;
 }
 
-void CornerPinFilter::calculateVertexQs() {
+void CornerPinFilter::getCornerPoints(const tgfx::Rect&, tgfx::Point points[4]) {
+  auto* cornerPinEffect = reinterpret_cast<const CornerPinEffect*>(effect);
+  points[0] = ToTGFX(cornerPinEffect->lowerLeft->getValueAt(layerFrame));
+  points[1] = ToTGFX(cornerPinEffect->lowerRight->getValueAt(layerFrame));
+  points[2] = ToTGFX(cornerPinEffect->upperLeft->getValueAt(layerFrame));
+  points[3] = ToTGFX(cornerPinEffect->upperRight->getValueAt(layerFrame));
+}
+
+void CornerPinFilter::calculateVertexQs(const tgfx::Rect& contentBounds) {
   // https://www.reedbeta.com/blog/quadrilateral-interpolation-part-1/
   // 计算2条对角线的交点：y1 = k1 * x1 + b1; y2 = k2 * x2 + b2
-  auto* cornerPinEffect = reinterpret_cast<const CornerPinEffect*>(effect);
-  auto lowerLeft = ToTGFX(cornerPinEffect->lowerLeft->getValueAt(layerFrame));
-  auto upperRight = ToTGFX(cornerPinEffect->upperRight->getValueAt(layerFrame));
-  auto lowerRight = ToTGFX(cornerPinEffect->lowerRight->getValueAt(layerFrame));
-  auto upperLeft = ToTGFX(cornerPinEffect->upperLeft->getValueAt(layerFrame));
+  tgfx::Point points[4] = {};
+  getCornerPoints(contentBounds, points);
+  auto lowerLeft = points[0];
+  auto lowerRight = points[1];
+  auto upperLeft = points[2];
+  auto upperRight = points[3];
   auto ll2ur_k = (upperRight.y - lowerLeft.y) / (upperRight.x - lowerLeft.x);
   auto ul2lr_k = (lowerRight.y - upperLeft.y) / (lowerRight.x - upperLeft.x);
   auto ll2ur_b = lowerLeft.y - ll2ur_k * lowerLeft.x;
@@ -108,11 +117,8 @@ void CornerPinFilter::calculateVertexQs() {
 std::vector<tgfx::Point> CornerPinFilter::computeVertices(const tgfx::Rect& contentBounds,
                                                           const tgfx::Rect&, const tgfx::Point&) {
   std::vector<tgfx::Point> vertices = {};
-  auto* cornerPinEffect = reinterpret_cast<const CornerPinEffect*>(effect);
-  tgfx::Point contentPoint[4] = {ToTGFX(cornerPinEffect->lowerLeft->getValueAt(layerFrame)),
-                                 ToTGFX(cornerPinEffect->lowerRight->getValueAt(layerFrame)),
-                                 ToTGFX(cornerPinEffect->upperLeft->getValueAt(layerFrame)),
-                                 ToTGFX(cornerPinEffect->upperRight->getValueAt(layerFrame))};
+  tgfx::Point contentPoint[4] = {};
+  getCornerPoints(contentBounds, contentPoint);
   tgfx::Point texturePoints[4] = {{0.0f, contentBounds.height()},
                                   {contentBounds.width(), contentBounds.height()},
                                   {0.0f, 0.0f},
@@ -129,7 +135,7 @@ void CornerPinFilter::bindVertices(tgfx::Context* context, const FilterSource* s
                                    const FilterTarget* target,
                                    const std::vector<tgfx::Point>& points) {
   std::vector<float> vertices = {};
-  calculateVertexQs();
+  calculateVertexQs(contentBounds);
   for (size_t i = 0, j = 0; i < points.size() && j < 4; j++) {
     auto vertexPoint = ToGLVertexPoint(target, source, contentBounds, points[i++]);
     vertices.push_back(vertexPoint.x);
@@ -42,8 +42,14 @@ class CornerPinFilter : public LayerFilter {
     return true;
   }
 
+  /**
+   * Returns the target positions of the content corners in the order of lower left, lower right,
+   * upper left and upper right.
+   */
+  virtual void getCornerPoints(const tgfx::Rect& contentBounds, tgfx::Point points[4]);
+
  private:
-  void calculateVertexQs();
+  void calculateVertexQs(const tgfx::Rect& contentBounds);
 
   Effect* effect = nullptr;
   float vertexQs[4] = {1.0f};
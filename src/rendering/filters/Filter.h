@@ -81,6 +81,23 @@ struct FilterTarget {
   std::array<float, 9> vertexMatrix = {};
 };
 
+/**
+ * The quality policy of a player that filters consult before drawing.
+ */
+struct FilterQuality {
+  /**
+   * If true, filters may trade precision for speed, such as taking fewer samples for slowly moving
+   * layers or blurring at a lower resolution. Otherwise, filters always render at full precision.
+   */
+  bool adaptive = false;
+
+  /**
+   * The quality level in the range of (0.0, 1.0]. It is lowered by the player when rendering
+   * misses the frame deadline, and restored when there is enough headroom.
+   */
+  float level = 1.0f;
+};
+
 class Filter {
  public:
   virtual ~Filter() = default;
@@ -17,6 +17,10 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "LayerFilter.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <unordered_map>
 #include "BrightnessContrastFilter.h"
 #include "BulgeFilter.h"
 #include "CornerPinFilter.h"
@@ -82,9 +86,58 @@ std::vector<tgfx::Point> ComputeVerticesForMotionBlurAndBulge(const tgfx::Rect&
   return vertices;
 }
 
+// 同一个 Context 内着色器源码相同的滤镜共用一个 program，每个滤镜实例只保留自己的 uniform 参数。
+// 以顶点和片元着色器源码组成的 pair 作为 key，避免两段源码直接拼接后出现相同的字符串。
+using ProgramKey = std::pair<std::string, std::string>;
+using ProgramMap = std::map<ProgramKey, std::weak_ptr<const FilterProgram>>;
+// 注册表中的条目数超过该值时才清理一次已释放的 program，之后该值调整为剩余条目数的两倍。
+static constexpr size_t MinProgramPruneCount = 32;
+static std::mutex programLocker = {};
+static std::unordered_map<uint32_t, ProgramMap>& programRegistry =
+    *new std::unordered_map<uint32_t, ProgramMap>();
+static size_t programCount = 0;
+static size_t programPruneCount = MinProgramPruneCount;
+
+static void RemoveExpiredPrograms() {
+  programCount = 0;
+  for (auto context = programRegistry.begin(); context != programRegistry.end();) {
+    auto& programs = context->second;
+    for (auto item = programs.begin(); item != programs.end();) {
+      item = item->second.expired() ? programs.erase(item) : std::next(item);
+    }
+    programCount += programs.size();
+    context = programs.empty() ? programRegistry.erase(context) : std::next(context);
+  }
+  programPruneCount = std::max(MinProgramPruneCount, programCount * 2);
+}
+
 std::shared_ptr<const FilterProgram> FilterProgram::Make(tgfx::Context* context,
                                                          const std::string& vertex,
                                                          const std::string& fragment) {
+  std::lock_guard<std::mutex> autoLock(programLocker);
+  auto& programs = programRegistry[context->uniqueID()];
+  auto numPrograms = programs.size();
+  auto& weakProgram = programs[{vertex, fragment}];
+  if (programs.size() > numPrograms) {
+    // 已释放的条目原地复用，只有新增的条目会推动清理。
+    programCount++;
+  }
+  auto filterProgram = weakProgram.lock();
+  // Context 销毁后 program 会被释放为 0，此时需要重新创建。
+  if (filterProgram != nullptr && filterProgram->program > 0) {
+    return filterProgram;
+  }
+  filterProgram = MakeProgram(context, vertex, fragment);
+  weakProgram = filterProgram;
+  if (programCount > programPruneCount) {
+    RemoveExpiredPrograms();
+  }
+  return filterProgram;
+}
+
+std::shared_ptr<const FilterProgram> FilterProgram::MakeProgram(tgfx::Context* context,
+                                                                const std::string& vertex,
+                                                                const std::string& fragment) {
   auto gl = tgfx::GLFunctions::Get(context);
   auto program = CreateGLProgram(context, vertex, fragment);
   if (program == 0) {
@@ -30,6 +30,11 @@ std::vector<tgfx::Point> ComputeVerticesForMotionBlurAndBulge(const tgfx::Rect&
 
 class FilterProgram : public tgfx::GLResource {
  public:
+  /**
+   * Returns a program compiled from the given shader sources. Programs are shared by all filters
+   * within the same context that have identical sources, so callers must set all of their uniforms
+   * before each draw.
+   */
   static std::shared_ptr<const FilterProgram> Make(tgfx::Context* context,
                                                    const std::string& vertex,
                                                    const std::string& fragment);
@@ -43,6 +48,10 @@ class FilterProgram : public tgfx::GLResource {
 
  private:
   FilterProgram() = default;
+
+  static std::shared_ptr<const FilterProgram> MakeProgram(tgfx::Context* context,
+                                                          const std::string& vertex,
+                                                          const std::string& fragment);
 };
 
 class LayerFilter : public Filter {
@@ -82,8 +91,16 @@ class LayerFilter : public Filter {
   virtual void update(Frame layerFrame, const tgfx::Rect& contentBounds,
                       const tgfx::Rect& transformedBounds, const tgfx::Point& filterScale);
 
+  /**
+   * 设置播放器当前的滤镜质量策略，在 update() 之前调用。
+   */
+  void setQuality(const FilterQuality& value) {
+    quality = value;
+  }
+
  protected:
   Frame layerFrame = 0;
+  FilterQuality quality = {};
   tgfx::Point filterScale = {};
   std::shared_ptr<const FilterProgram> filterProgram = nullptr;
 
@@ -17,11 +17,14 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "MotionBlurFilter.h"
+#include <algorithm>
 #include "rendering/caches/LayerCache.h"
 #include "rendering/filters/utils/FilterHelper.h"
 
 namespace pag {
 #define MOTION_BLUR_SCALE_FACTOR 1.2f
+#define MOTION_BLUR_MAX_SAMPLES 37
+#define MOTION_BLUR_MIN_SAMPLES 5
 
 static const char MOTIONBLUR_VERTEX_SHADER[] = R"(
         #version 100
@@ -55,7 +58,8 @@ static const char MOTIONBLUR_FRAGMENT_SHADER[] = R"(
         uniform sampler2D uTextureInput;
         uniform float uVelCenter;
         uniform float maxDistance;
-        const int kSamplesPerFrame = 37;
+        uniform float uSamples;
+        const int kMaxSamplesPerFrame = 37;
         void main() {
             vec2 velocity = vCurrPosition.xy - vPrevPosition.xy;
             float distance = length(velocity);
@@ -67,8 +71,11 @@ static const char MOTIONBLUR_FRAGMENT_SHADER[] = R"(
             float reachedEdgeCount = 0.0;
 
             vec4 result = texture2D(uTextureInput, vertexColor);
-            for (int i = 1; i < kSamplesPerFrame; ++i) {
-                target = vertexColor + velocity * (float(i) / float(kSamplesPerFrame - 1) - uVelCenter);
+            for (int i = 1; i < kMaxSamplesPerFrame; ++i) {
+                if (float(i) >= uSamples) {
+                    break;
+                }
+                target = vertexColor + velocity * (float(i) / (uSamples - 1.0) - uVelCenter);
 
                 edgeDetect = abs(step(vec2(1.0), target) - vec2(1.0)) * step(vec2(0.0), target);
                 edgeDetectValue = edgeDetect.x * edgeDetect.y;
@@ -77,7 +84,7 @@ static const char MOTIONBLUR_FRAGMENT_SHADER[] = R"(
 
                 result += texture2D(uTextureInput, target) * edgeDetectValue;
             }
-            gl_FragColor = (reachedEdgeCount < float(kSamplesPerFrame) - 1.0) ? result / float(kSamplesPerFrame) : vec4(0.0);
+            gl_FragColor = (reachedEdgeCount < uSamples - 1.0) ? result / uSamples : vec4(0.0);
         }
     )";
 
@@ -113,6 +120,34 @@ void MotionBlurFilter::onPrepareProgram(tgfx::Context* context, unsigned int pro
   transformHandle = gl->getUniformLocation(program, "uTransform");
   velCenterHandle = gl->getUniformLocation(program, "uVelCenter");
   maxDistanceHandle = gl->getUniformLocation(program, "maxDistance");
+  samplesHandle = gl->getUniformLocation(program, "uSamples");
+}
+
+// 自适应质量下根据运动距离决定采样数，慢速移动的图层无需每帧采样 37 次。
+static int CalculateSampleCount(const tgfx::Matrix& previousMatrix,
+                                const tgfx::Matrix& currentMatrix, const tgfx::Rect& contentBounds,
+                                const tgfx::Point& filterScale, const FilterQuality& quality) {
+  if (!quality.adaptive) {
+    return MOTION_BLUR_MAX_SAMPLES;
+  }
+  tgfx::Point previous[4] = {{contentBounds.left, contentBounds.top},
+                             {contentBounds.right, contentBounds.top},
+                             {contentBounds.left, contentBounds.bottom},
+                             {contentBounds.right, contentBounds.bottom}};
+  tgfx::Point current[4] = {previous[0], previous[1], previous[2], previous[3]};
+  previousMatrix.mapPoints(previous, 4);
+  currentMatrix.mapPoints(current, 4);
+  float maxDistance = 0.0f;
+  for (int i = 0; i < 4; i++) {
+    maxDistance = std::max(maxDistance, tgfx::Point::Distance(previous[i], current[i]));
+  }
+  // 着色器里的位移最多为内容尺寸的 (MOTION_BLUR_SCALE_FACTOR - 1) / 2。
+  auto distanceLimit = std::max(contentBounds.width(), contentBounds.height()) *
+                       (MOTION_BLUR_SCALE_FACTOR - 1.0f) * 0.5f;
+  maxDistance = std::min(maxDistance, distanceLimit);
+  maxDistance *= std::max(fabsf(filterScale.x), fabsf(filterScale.y));
+  auto samples = static_cast<int>(ceilf(maxDistance * quality.level)) + 1;
+  return std::max(MOTION_BLUR_MIN_SAMPLES, std::min(MOTION_BLUR_MAX_SAMPLES, samples));
 }
 
 bool MotionBlurFilter::updateLayer(Layer* targetLayer, Frame layerFrame) {
@@ -124,7 +159,9 @@ bool MotionBlurFilter::updateLayer(Layer* targetLayer, Frame layerFrame) {
 }
 
 void MotionBlurFilter::onUpdateParams(tgfx::Context* context, const tgfx::Rect& contentBounds,
-                                      const tgfx::Point&) {
+                                      const tgfx::Point& filterScale) {
+  auto samples =
+      CalculateSampleCount(previousMatrix, currentMatrix, contentBounds, filterScale, quality);
   auto width = static_cast<int>(contentBounds.width());
   auto height = static_cast<int>(contentBounds.height());
   auto origin = tgfx::ImageOrigin::TopLeft;
@@ -141,6 +178,7 @@ void MotionBlurFilter::onUpdateParams(tgfx::Context* context, const tgfx::Rect&
   gl->uniformMatrix3fv(transformHandle, 1, GL_FALSE, currentGLMatrix.data());
   gl->uniform1f(velCenterHandle, scaling ? 0.0f : 0.5f);
   gl->uniform1f(maxDistanceHandle, (MOTION_BLUR_SCALE_FACTOR - 1.0) * 0.5f);
+  gl->uniform1f(samplesHandle, static_cast<float>(samples));
 }
 
 std::vector<tgfx::Point> MotionBlurFilter::computeVertices(const tgfx::Rect& inputBounds,
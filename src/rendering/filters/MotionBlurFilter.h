@@ -53,5 +53,6 @@ class MotionBlurFilter : public LayerFilter {
   int transformHandle = 0;
   int velCenterHandle = 0;
   int maxDistanceHandle = 0;
+  int samplesHandle = 0;
 };
 }  // namespace pag
@@ -0,0 +1,291 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "Transform3DFilter.h"
+#include <algorithm>
+#include "base/utils/MathUtil.h"
+#include "rendering/renderers/TransformRenderer.h"
+#include "rendering/utils/Transform.h"
+
+namespace pag {
+// After Effects 在没有摄像机时使用 50mm 的默认摄像机，zoom 为合成宽度的 50/36 倍。
+static constexpr float DefaultCameraZoomFactor = 50.0f / 36.0f;
+// 投影后深度小于该值的点视为位于摄像机之后。
+static constexpr float MinProjectionDepth = 1.0f;
+
+/**
+ * An affine 3D transform that maps column vectors, only the upper 3x4 part is stored.
+ */
+struct Matrix3D {
+  float values[3][4] = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}};
+
+  static Matrix3D MakeTrans(float x, float y, float z) {
+    Matrix3D matrix = {};
+    matrix.values[0][3] = x;
+    matrix.values[1][3] = y;
+    matrix.values[2][3] = z;
+    return matrix;
+  }
+
+  static Matrix3D MakeScale(float x, float y, float z) {
+    Matrix3D matrix = {};
+    matrix.values[0][0] = x;
+    matrix.values[1][1] = y;
+    matrix.values[2][2] = z;
+    return matrix;
+  }
+
+  static Matrix3D MakeRotate(int axis, float degrees) {
+    Matrix3D matrix = {};
+    auto radians = DegreesToRadians(degrees);
+    auto c = cosf(radians);
+    auto s = sinf(radians);
+    auto i = (axis + 1) % 3;
+    auto j = (axis + 2) % 3;
+    matrix.values[i][i] = c;
+    matrix.values[i][j] = -s;
+    matrix.values[j][i] = s;
+    matrix.values[j][j] = c;
+    return matrix;
+  }
+
+  static Matrix3D MakeFrom(const tgfx::Matrix& matrix) {
+    Matrix3D result = {};
+    result.values[0][0] = matrix.getScaleX();
+    result.values[0][1] = matrix.getSkewX();
+    result.values[0][3] = matrix.getTranslateX();
+    result.values[1][0] = matrix.getSkewY();
+    result.values[1][1] = matrix.getScaleY();
+    result.values[1][3] = matrix.getTranslateY();
+    return result;
+  }
+
+  Matrix3D operator*(const Matrix3D& other) const {
+    Matrix3D result = {};
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 4; col++) {
+        float value = col == 3 ? values[row][3] : 0.0f;
+        for (int k = 0; k < 3; k++) {
+          value += values[row][k] * other.values[k][col];
+        }
+        result.values[row][col] = value;
+      }
+    }
+    return result;
+  }
+
+  Point3D mapPoint(float x, float y, float z) const {
+    Point3D result = {};
+    result.x = values[0][0] * x + values[0][1] * y + values[0][2] * z + values[0][3];
+    result.y = values[1][0] * x + values[1][1] * y + values[1][2] * z + values[1][3];
+    result.z = values[2][0] * x + values[2][1] * y + values[2][2] * z + values[2][3];
+    return result;
+  }
+
+  // The camera may inherit scales and skews from its 2D parents, so the inverse is not limited to
+  // rigid transforms. Returns false if the matrix is not invertible.
+  bool invert(Matrix3D* result) const {
+    auto& m = values;
+    float cofactors[3][3] = {
+        {m[1][1] * m[2][2] - m[1][2] * m[2][1], m[0][2] * m[2][1] - m[0][1] * m[2][2],
+         m[0][1] * m[1][2] - m[0][2] * m[1][1]},
+        {m[1][2] * m[2][0] - m[1][0] * m[2][2], m[0][0] * m[2][2] - m[0][2] * m[2][0],
+         m[0][2] * m[1][0] - m[0][0] * m[1][2]},
+        {m[1][0] * m[2][1] - m[1][1] * m[2][0], m[0][1] * m[2][0] - m[0][0] * m[2][1],
+         m[0][0] * m[1][1] - m[0][1] * m[1][0]}};
+    auto determinant =
+        m[0][0] * cofactors[0][0] + m[0][1] * cofactors[1][0] + m[0][2] * cofactors[2][0];
+    if (FloatNearlyZero(determinant)) {
+      return false;
+    }
+    auto inverseDeterminant = 1.0f / determinant;
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 3; col++) {
+        result->values[row][col] = cofactors[row][col] * inverseDeterminant;
+      }
+    }
+    for (int row = 0; row < 3; row++) {
+      result->values[row][3] =
+          -(result->values[row][0] * m[0][3] + result->values[row][1] * m[1][3] +
+            result->values[row][2] * m[2][3]);
+    }
+    return true;
+  }
+};
+
+static Point3D GetPosition(Transform3D* transform, Frame layerFrame) {
+  if (transform->position != nullptr) {
+    return transform->position->getValueAt(layerFrame);
+  }
+  return Point3D::Make(transform->xPosition->getValueAt(layerFrame),
+                       transform->yPosition->getValueAt(layerFrame),
+                       transform->zPosition->getValueAt(layerFrame));
+}
+
+static Matrix3D GetRotation(Transform3D* transform, Frame layerFrame) {
+  auto orientation = transform->orientation->getValueAt(layerFrame);
+  return Matrix3D::MakeRotate(0, orientation.x) * Matrix3D::MakeRotate(1, orientation.y) *
+         Matrix3D::MakeRotate(2, orientation.z) *
+         Matrix3D::MakeRotate(0, transform->xRotation->getValueAt(layerFrame)) *
+         Matrix3D::MakeRotate(1, transform->yRotation->getValueAt(layerFrame)) *
+         Matrix3D::MakeRotate(2, transform->zRotation->getValueAt(layerFrame));
+}
+
+static Matrix3D GetLayerMatrix(Transform3D* transform, Frame layerFrame) {
+  auto anchorPoint = transform->anchorPoint->getValueAt(layerFrame);
+  auto scale = transform->scale->getValueAt(layerFrame);
+  auto position = GetPosition(transform, layerFrame);
+  return Matrix3D::MakeTrans(position.x, position.y, position.z) *
+         GetRotation(transform, layerFrame) * Matrix3D::MakeScale(scale.x, scale.y, scale.z) *
+         Matrix3D::MakeTrans(-anchorPoint.x, -anchorPoint.y, -anchorPoint.z);
+}
+
+static Matrix3D GetParentMatrix(Layer* layer, Frame layerFrame) {
+  Matrix3D matrix = {};
+  for (auto parent = layer->parent; parent != nullptr; parent = parent->parent) {
+    if (parent->transform3D != nullptr) {
+      matrix = GetLayerMatrix(parent->transform3D, layerFrame) * matrix;
+    } else if (parent->transform != nullptr) {
+      Transform transform = {};
+      RenderTransform(&transform, parent->transform, layerFrame);
+      matrix = Matrix3D::MakeFrom(transform.matrix) * matrix;
+    }
+  }
+  return matrix;
+}
+
+// 双节点摄像机的锚点即目标点，摄像机的 z 轴朝向目标点。
+static Matrix3D GetLookAtRotation(const Point3D& position, const Point3D& target) {
+  Matrix3D matrix = {};
+  float forward[3] = {target.x - position.x, target.y - position.y, target.z - position.z};
+  auto length = sqrtf(forward[0] * forward[0] + forward[1] * forward[1] + forward[2] * forward[2]);
+  if (FloatNearlyZero(length)) {
+    return matrix;
+  }
+  for (auto& value : forward) {
+    value /= length;
+  }
+  // right = down x forward, the y axis points down in compositions.
+  float right[3] = {forward[2], 0, -forward[0]};
+  auto rightLength = sqrtf(right[0] * right[0] + right[2] * right[2]);
+  if (FloatNearlyZero(rightLength)) {
+    return matrix;
+  }
+  right[0] /= rightLength;
+  right[2] /= rightLength;
+  float down[3] = {forward[1] * right[2] - forward[2] * right[1],
+                   forward[2] * right[0] - forward[0] * right[2],
+                   forward[0] * right[1] - forward[1] * right[0]};
+  for (int row = 0; row < 3; row++) {
+    matrix.values[row][0] = right[row];
+    matrix.values[row][1] = down[row];
+    matrix.values[row][2] = forward[row];
+  }
+  return matrix;
+}
+
+static CameraLayer* FindActiveCamera(Layer* layer, Frame layerFrame) {
+  auto composition = layer->containingComposition;
+  if (composition == nullptr) {
+    return nullptr;
+  }
+  // The layers in a composition are stored from top to bottom, the topmost camera wins.
+  for (auto child : composition->layers) {
+    if (child->type() == LayerType::Camera && child->isActive && child->transform3D != nullptr &&
+        layerFrame >= child->startTime && layerFrame < child->startTime + child->duration) {
+      return static_cast<CameraLayer*>(child);
+    }
+  }
+  return nullptr;
+}
+
+static bool ProjectRect(Layer* layer, Frame layerFrame, const tgfx::Rect& rect,
+                        tgfx::Point points[4]) {
+  auto composition = layer->containingComposition;
+  if (composition == nullptr || layer->transform3D == nullptr) {
+    return false;
+  }
+  auto centerX = static_cast<float>(composition->width) * 0.5f;
+  auto centerY = static_cast<float>(composition->height) * 0.5f;
+  auto zoom = static_cast<float>(composition->width) * DefaultCameraZoomFactor;
+  auto viewMatrix = Matrix3D::MakeTrans(-centerX, -centerY, zoom);
+  auto camera = FindActiveCamera(layer, layerFrame);
+  if (camera != nullptr) {
+    auto transform = camera->transform3D;
+    auto position = GetPosition(transform, layerFrame);
+    auto target = transform->anchorPoint->getValueAt(layerFrame);
+    auto cameraMatrix = GetParentMatrix(camera, layerFrame) *
+                        Matrix3D::MakeTrans(position.x, position.y, position.z) *
+                        GetLookAtRotation(position, target) * GetRotation(transform, layerFrame);
+    if (!cameraMatrix.invert(&viewMatrix)) {
+      return false;
+    }
+    zoom = camera->cameraOption->zoom->getValueAt(layerFrame);
+  }
+  auto matrix = viewMatrix * GetParentMatrix(layer, layerFrame) *
+                GetLayerMatrix(layer->transform3D, layerFrame);
+  tgfx::Point corners[4] = {{rect.left, rect.bottom},
+                            {rect.right, rect.bottom},
+                            {rect.left, rect.top},
+                            {rect.right, rect.top}};
+  for (int i = 0; i < 4; i++) {
+    auto point = matrix.mapPoint(corners[i].x, corners[i].y, 0);
+    if (point.z < MinProjectionDepth) {
+      return false;
+    }
+    points[i].set(point.x * zoom / point.z + centerX, point.y * zoom / point.z + centerY);
+  }
+  return true;
+}
+
+bool Transform3DFilter::TransformBounds(tgfx::Rect* bounds, Layer* layer, Frame layerFrame) {
+  tgfx::Point points[4] = {};
+  if (!ProjectRect(layer, layerFrame, *bounds, points)) {
+    bounds->setEmpty();
+    return false;
+  }
+  bounds->setLTRB(points[0].x, points[0].y, points[0].x, points[0].y);
+  for (int i = 1; i < 4; i++) {
+    bounds->left = std::min(bounds->left, points[i].x);
+    bounds->top = std::min(bounds->top, points[i].y);
+    bounds->right = std::max(bounds->right, points[i].x);
+    bounds->bottom = std::max(bounds->bottom, points[i].y);
+  }
+  return true;
+}
+
+Transform3DFilter::Transform3DFilter() : CornerPinFilter(nullptr) {
+}
+
+bool Transform3DFilter::updateLayer(Layer* targetLayer, Frame layerFrame) {
+  if (targetLayer == nullptr || targetLayer->transform3D == nullptr) {
+    return false;
+  }
+  layer = targetLayer;
+  projectedFrame = layerFrame;
+  return true;
+}
+
+void Transform3DFilter::getCornerPoints(const tgfx::Rect& contentBounds, tgfx::Point points[4]) {
+  if (!ProjectRect(layer, projectedFrame, contentBounds, points)) {
+    for (int i = 0; i < 4; i++) {
+      points[i] = tgfx::Point::Zero();
+    }
+  }
+}
+}  // namespace pag
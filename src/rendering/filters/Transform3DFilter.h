@@ -0,0 +1,53 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "CornerPinFilter.h"
+
+namespace pag {
+/**
+ * Transform3DFilter renders a 3D layer by projecting its content plane into the containing
+ * composition through the active camera layer, or the default 50mm camera of After Effects if
+ * there is no camera. The projected quad is drawn with perspective-correct texture coordinates.
+ * Each 3D layer is projected on its own, the layers are still composited in their layer order
+ * rather than sorted by depth.
+ */
+class Transform3DFilter : public CornerPinFilter {
+ public:
+  /**
+   * Maps the content bounds of the 3D layer to the bounds of its projection in the containing
+   * composition. Returns false if the layer is not visible, for example, it is behind the camera.
+   */
+  static bool TransformBounds(tgfx::Rect* bounds, Layer* layer, Frame layerFrame);
+
+  Transform3DFilter();
+
+  /**
+   * Updates the layer to project, returns false if the layer is not visible at the layer frame.
+   */
+  bool updateLayer(Layer* layer, Frame layerFrame);
+
+ protected:
+  void getCornerPoints(const tgfx::Rect& contentBounds, tgfx::Point points[4]) override;
+
+ private:
+  Layer* layer = nullptr;
+  Frame projectedFrame = 0;
+};
+}  // namespace pag
@@ -17,10 +17,13 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GlowFilter.h"
+#include <algorithm>
 #include "rendering/filters/utils/FilterBuffer.h"
 #include "rendering/filters/utils/FilterHelper.h"
 
 namespace pag {
+static constexpr float MinResizeRatio = 0.1f;
+
 GlowFilter::GlowFilter(Effect* effect) : effect(effect) {
   blurFilterH = new GlowBlurFilter(BlurDirection::Horizontal);
   blurFilterV = new GlowBlurFilter(BlurDirection::Vertical);
@@ -53,6 +56,10 @@ void GlowFilter::update(Frame frame, const tgfx::Rect& contentBounds,
   auto glowEffect = static_cast<GlowEffect*>(effect);
   auto glowRadius = glowEffect->glowRadius->getValueAt(layerFrame);
   resizeRatio = 1.0f - glowRadius / 1500.f;
+  if (quality.adaptive) {
+    // 模糊半径越大，降采样带来的损失越不明显，低质量时按质量等级进一步缩小模糊的分辨率。
+    resizeRatio = std::max(MinResizeRatio, resizeRatio * quality.level);
+  }
   auto blurBounds = contentBounds;
   blurBounds.scale(resizeRatio, resizeRatio);
   blurBounds.offsetTo(contentBounds.left, contentBounds.top);
@@ -17,20 +17,45 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "Filter3DFactory.h"
+#include "rendering/filters/Transform3DFilter.h"
 
 namespace pag {
 
-bool Make3DLayerNode(std::vector<FilterNode>&, tgfx::Rect&, const FilterList*, RenderCache*,
-                     tgfx::Rect&, tgfx::Point&) {
+bool Make3DLayerNode(std::vector<FilterNode>& filterNodes, tgfx::Rect& clipBounds,
+                     const FilterList* filterList, RenderCache* renderCache,
+                     tgfx::Rect& filterBounds, tgfx::Point& effectScale) {
+  auto layer = filterList->layer;
+  if (layer->transform3D == nullptr) {
+    return true;
+  }
+  auto filter = static_cast<Transform3DFilter*>(renderCache->getTransform3DFilter());
+  if (filter == nullptr || !filter->updateLayer(layer, filterList->layerFrame)) {
+    return false;
+  }
+  auto oldBounds = filterBounds;
+  if (!Transform3DFilter::TransformBounds(&filterBounds, layer, filterList->layerFrame)) {
+    return false;
+  }
+  filterBounds.roundOut();
+  filter->update(filterList->layerFrame, oldBounds, filterBounds, effectScale);
+  if (!filterBounds.intersect(clipBounds)) {
+    return false;
+  }
+  filterNodes.emplace_back(filter, filterBounds);
   return true;
 }
 
-Filter* Make3DFilter(tgfx::Context*) {
-  return nullptr;
+Filter* Make3DFilter(tgfx::Context* context) {
+  auto filter = new Transform3DFilter();
+  if (!filter->initialize(context)) {
+    delete filter;
+    return nullptr;
+  }
+  return filter;
 }
 
 bool Has3DSupport() {
-  return false;
+  return true;
 }
 
-}  // namespace pag
\ No newline at end of file
+}  // namespace pag
@@ -0,0 +1,169 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CodecImageProxy.h"
+#include <algorithm>
+#include <cmath>
+#include "rendering/caches/RenderCache.h"
+#include "tgfx/core/Bitmap.h"
+#include "tgfx/core/Buffer.h"
+
+namespace pag {
+// 最多缩小到原图的 1/64 解码，更小的显示尺寸由 GPU 继续缩放。
+static constexpr float MIN_DECODING_SCALE = 1.0f / 64.0f;
+
+/**
+ * Rounds the scale factor up to a power of 1/2, so that the image is decoded again at most a few
+ * times when the display scale grows gradually. Returns 1.0 if the image should be decoded at its
+ * original size.
+ */
+static float GetDecodingScale(float scaleFactor) {
+  auto decodingScale = 1.0f;
+  while (decodingScale * 0.5f >= scaleFactor && decodingScale > MIN_DECODING_SCALE) {
+    decodingScale *= 0.5f;
+  }
+  return decodingScale;
+}
+
+static void DownsamplePixels(const tgfx::ImageInfo& srcInfo, const uint8_t* srcPixels,
+                             const tgfx::ImageInfo& dstInfo, uint8_t* dstPixels) {
+  int64_t srcWidth = srcInfo.width();
+  int64_t srcHeight = srcInfo.height();
+  int64_t dstWidth = dstInfo.width();
+  int64_t dstHeight = dstInfo.height();
+  for (int64_t dstY = 0; dstY < dstHeight; dstY++) {
+    auto startY = dstY * srcHeight / dstHeight;
+    auto endY = std::max(startY + 1, (dstY + 1) * srcHeight / dstHeight);
+    auto dstRow = dstPixels + dstY * static_cast<int64_t>(dstInfo.rowBytes());
+    for (int64_t dstX = 0; dstX < dstWidth; dstX++) {
+      auto startX = dstX * srcWidth / dstWidth;
+      auto endX = std::max(startX + 1, (dstX + 1) * srcWidth / dstWidth);
+      // The pixels are premultiplied, so averaging them directly gives the correct result.
+      uint32_t sum[4] = {0, 0, 0, 0};
+      for (auto y = startY; y < endY; y++) {
+        auto srcRow = srcPixels + y * static_cast<int64_t>(srcInfo.rowBytes());
+        for (auto x = startX; x < endX; x++) {
+          for (int i = 0; i < 4; i++) {
+            sum[i] += srcRow[x * 4 + i];
+          }
+        }
+      }
+      auto count = static_cast<uint32_t>((endY - startY) * (endX - startX));
+      for (int i = 0; i < 4; i++) {
+        dstRow[dstX * 4 + i] = static_cast<uint8_t>((sum[i] + count / 2) / count);
+      }
+    }
+  }
+}
+
+static std::shared_ptr<tgfx::Image> DecodeScaledImage(std::shared_ptr<tgfx::ImageCodec> codec,
+                                                      float scaleFactor) {
+  auto srcInfo = tgfx::ImageInfo::Make(codec->width(), codec->height(),
+                                       tgfx::ColorType::RGBA_8888, tgfx::AlphaType::Premultiplied);
+  tgfx::Buffer srcBuffer(srcInfo.byteSize());
+  if (srcBuffer.data() == nullptr || !codec->readPixels(srcInfo, srcBuffer.data())) {
+    return nullptr;
+  }
+  auto width = static_cast<int>(ceilf(static_cast<float>(codec->width()) * scaleFactor));
+  auto height = static_cast<int>(ceilf(static_cast<float>(codec->height()) * scaleFactor));
+  auto dstInfo = tgfx::ImageInfo::Make(width, height, tgfx::ColorType::RGBA_8888,
+                                       tgfx::AlphaType::Premultiplied);
+  tgfx::Buffer dstBuffer(dstInfo.byteSize());
+  if (dstBuffer.data() == nullptr) {
+    return nullptr;
+  }
+  DownsamplePixels(srcInfo, srcBuffer.bytes(), dstInfo, static_cast<uint8_t*>(dstBuffer.data()));
+  tgfx::Bitmap bitmap(width, height, false);
+  bitmap.writePixels(dstInfo, dstBuffer.data());
+  return tgfx::Image::MakeFrom(bitmap);
+}
+
+CodecImageProxy::CodecImageProxy(ID assetID, std::shared_ptr<tgfx::ImageCodec> codec,
+                                 std::shared_ptr<tgfx::Image> image)
+    : assetID(assetID), codec(std::move(codec)), image(std::move(image)) {
+}
+
+void CodecImageProxy::prepareImage(RenderCache* cache) const {
+  auto maxScaleFactor = cache->getAssetMaxScale(assetID);
+  if (maxScaleFactor <= 0) {
+    return;
+  }
+  auto decodingScale = GetDecodingScale(maxScaleFactor);
+  if (decodingScale >= 1.0f) {
+    cache->prepareAssetImage(assetID, this);
+    return;
+  }
+  if (cache->hasSnapshot(assetID)) {
+    return;
+  }
+  std::lock_guard<std::mutex> autoLock(locker);
+  scheduleScaledImage(decodingScale);
+}
+
+std::shared_ptr<tgfx::Image> CodecImageProxy::getImage(RenderCache* cache) const {
+  return cache->getAssetImage(assetID, this);
+}
+
+std::shared_ptr<tgfx::Image> CodecImageProxy::getScaledImage(RenderCache* cache,
+                                                             float scaleFactor) const {
+  auto decodingScale = GetDecodingScale(scaleFactor);
+  if (decodingScale >= 1.0f) {
+    return getImage(cache);
+  }
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    if (pendingImage != nullptr && pendingImage->scaleFactor >= decodingScale) {
+      task->wait();
+      if (pendingImage->image != nullptr) {
+        scaledImage = pendingImage;
+      }
+      pendingImage = nullptr;
+      task = nullptr;
+    }
+    if (scaledImage != nullptr && scaledImage->scaleFactor >= decodingScale) {
+      return scaledImage->image;
+    }
+    // The scaled image is never decoded on the render thread, the original image is drawn instead
+    // until the background decoding finishes.
+    scheduleScaledImage(decodingScale);
+  }
+  return getImage(cache);
+}
+
+void CodecImageProxy::scheduleScaledImage(float decodingScale) const {
+  if ((scaledImage != nullptr && scaledImage->scaleFactor >= decodingScale) ||
+      (pendingImage != nullptr && pendingImage->scaleFactor >= decodingScale)) {
+    return;
+  }
+  auto result = std::make_shared<ScaledImage>();
+  result->scaleFactor = decodingScale;
+  task = tgfx::Task::Run([codec = codec, result]() {
+    result->image = DecodeScaledImage(codec, result->scaleFactor);
+  });
+  pendingImage = result;
+}
+
+void CodecImageProxy::releaseScaledImage() const {
+  std::lock_guard<std::mutex> autoLock(locker);
+  scaledImage = nullptr;
+}
+
+std::shared_ptr<tgfx::Image> CodecImageProxy::makeImage(RenderCache*) const {
+  return image;
+}
+}  // namespace pag
@@ -0,0 +1,83 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <mutex>
+#include "pag/types.h"
+#include "rendering/graphics/ImageProxy.h"
+#include "tgfx/core/ImageCodec.h"
+#include "tgfx/core/Task.h"
+
+namespace pag {
+/**
+ * CodecImageProxy draws an encoded image at the largest size it is actually displayed. If the image
+ * is displayed at half of its original size or smaller, it is decoded at a reduced size instead of
+ * decoding and uploading the full resolution, and it is decoded again at a larger size when the
+ * display scale grows later. The scaled images are always decoded on a background thread, the
+ * original image is drawn until they are ready.
+ */
+class CodecImageProxy : public ImageProxy {
+ public:
+  CodecImageProxy(ID assetID, std::shared_ptr<tgfx::ImageCodec> codec,
+                  std::shared_ptr<tgfx::Image> image);
+
+  int width() const override {
+    return image->width();
+  }
+
+  int height() const override {
+    return image->height();
+  }
+
+  bool isTemporary() const override {
+    return false;
+  }
+
+  void prepareImage(RenderCache* cache) const override;
+
+  std::shared_ptr<tgfx::Image> getImage(RenderCache* cache) const override;
+
+  std::shared_ptr<tgfx::Image> getScaledImage(RenderCache* cache, float scaleFactor) const override;
+
+  void releaseScaledImage() const override;
+
+ protected:
+  std::shared_ptr<tgfx::Image> makeImage(RenderCache* cache) const override;
+
+ private:
+  struct ScaledImage {
+    float scaleFactor = 0.0f;
+    std::shared_ptr<tgfx::Image> image = nullptr;
+  };
+
+  ID assetID = 0;
+  std::shared_ptr<tgfx::ImageCodec> codec = nullptr;
+  std::shared_ptr<tgfx::Image> image = nullptr;
+  mutable std::mutex locker = {};
+  mutable std::shared_ptr<ScaledImage> scaledImage = nullptr;
+  mutable std::shared_ptr<ScaledImage> pendingImage = nullptr;
+  mutable std::shared_ptr<tgfx::Task> task = nullptr;
+
+  /**
+   * Starts decoding the image at the specified scale on a background thread, unless a scaled image
+   * large enough is decoded or pending already. The locker must be held by the caller.
+   */
+  void scheduleScaledImage(float decodingScale) const;
+};
+}  // namespace pag
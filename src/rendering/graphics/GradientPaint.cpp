@@ -17,6 +17,10 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GradientPaint.h"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "base/utils/HashUtil.h"
 #include "base/utils/Interpolate.h"
 #include "base/utils/TGFXCast.h"
 
@@ -55,11 +59,11 @@ void ConvertAlphaStop(const GradientColorHandle& gradientColor, std::vector<Opac
   }
 }
 
-GradientPaint::GradientPaint(Enum fillType, Point startPoint, Point endPoint,
-                             const GradientColorHandle& gradientColor, const tgfx::Matrix& matrix,
-                             bool reverse)
-    : gradientType(fillType), startPoint(ToTGFX(startPoint)), endPoint(ToTGFX(endPoint)),
-      matrix(matrix) {
+static std::shared_ptr<GradientRamp> MakeGradientRamp(const GradientColorHandle& gradientColor,
+                                                     bool reverse) {
+  auto ramp = std::make_shared<GradientRamp>();
+  auto& colors = ramp->colors;
+  auto& positions = ramp->positions;
   std::vector<Color> colorValues;
   std::vector<float> colorPositions;
   ConvertColorStop(gradientColor, colorValues, colorPositions);
@@ -120,15 +124,90 @@ GradientPaint::GradientPaint(Enum fillType, Point startPoint, Point endPoint,
     colors.push_back(color4f);
   }
   if (reverse) {
-    std::swap(startPoint, endPoint);
     std::reverse(colors.begin(), colors.end());
     std::reverse(positions.begin(), positions.end());
     std::transform(positions.begin(), positions.end(), positions.begin(),
                    [](float x) { return 1.f - x; });
   }
+  return ramp;
+}
+
+// 合并后的色标按渐变的数值缓存，动画渐变每帧插值出的新对象只要数值相同（如循环播放、多个播放器播放同一
+// 文件）也能命中。缓存数量有上限，按最近使用的顺序淘汰，每次查询的开销与缓存数量无关。
+static constexpr size_t MaxGradientRamps = 256;
+
+struct GradientRampEntry {
+  uint64_t hash = 0;
+  std::vector<float> key = {};
+  std::shared_ptr<GradientRamp> ramp = nullptr;
+};
+
+static std::mutex rampLocker = {};
+static std::list<GradientRampEntry> rampLRU = {};
+static std::unordered_map<uint64_t, std::list<GradientRampEntry>::iterator> rampCaches = {};
+
+static std::vector<float> MakeGradientRampKey(const GradientColorHandle& gradientColor,
+                                              bool reverse) {
+  std::vector<float> key = {};
+  key.reserve(2 + gradientColor->colorStops.size() * 5 + gradientColor->alphaStops.size() * 3);
+  key.push_back(reverse ? 1.0f : 0.0f);
+  key.push_back(static_cast<float>(gradientColor->colorStops.size()));
+  for (auto& stop : gradientColor->colorStops) {
+    key.push_back(stop.position);
+    key.push_back(stop.midpoint);
+    key.push_back(stop.color.red);
+    key.push_back(stop.color.green);
+    key.push_back(stop.color.blue);
+  }
+  for (auto& stop : gradientColor->alphaStops) {
+    key.push_back(stop.position);
+    key.push_back(stop.midpoint);
+    key.push_back(stop.opacity);
+  }
+  return key;
+}
+
+static std::shared_ptr<const GradientRamp> GetGradientRamp(const GradientColorHandle& gradientColor,
+                                                           bool reverse) {
+  auto key = MakeGradientRampKey(gradientColor, reverse);
+  auto hash = Hash64(key.data(), key.size() * sizeof(float));
+  std::lock_guard<std::mutex> autoLock(rampLocker);
+  auto result = rampCaches.find(hash);
+  if (result != rampCaches.end()) {
+    auto position = result->second;
+    if (position->key == key) {
+      rampLRU.splice(rampLRU.begin(), rampLRU, position);
+      return position->ramp;
+    }
+    rampLRU.erase(position);
+    rampCaches.erase(result);
+  }
+  GradientRampEntry entry = {};
+  entry.hash = hash;
+  entry.key = std::move(key);
+  entry.ramp = MakeGradientRamp(gradientColor, reverse);
+  rampLRU.push_front(std::move(entry));
+  rampCaches[hash] = rampLRU.begin();
+  if (rampLRU.size() > MaxGradientRamps) {
+    rampCaches.erase(rampLRU.back().hash);
+    rampLRU.pop_back();
+  }
+  return rampLRU.front().ramp;
+}
+
+GradientPaint::GradientPaint(Enum fillType, Point startPoint, Point endPoint,
+                             const GradientColorHandle& gradientColor, const tgfx::Matrix& matrix,
+                             bool reverse)
+    : gradientType(fillType), startPoint(ToTGFX(startPoint)), endPoint(ToTGFX(endPoint)),
+      matrix(matrix), ramp(GetGradientRamp(gradientColor, reverse)) {
 }
 
 std::shared_ptr<tgfx::Shader> GradientPaint::getShader() const {
+  if (ramp == nullptr) {
+    return nullptr;
+  }
+  const auto& colors = ramp->colors;
+  const auto& positions = ramp->positions;
   std::shared_ptr<tgfx::Shader> shader;
   if (gradientType == GradientFillType::Linear) {
     shader = tgfx::Shader::MakeLinearGradient(startPoint, endPoint, colors, positions);
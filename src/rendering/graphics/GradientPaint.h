@@ -25,6 +25,15 @@
 #include "tgfx/core/Shader.h"
 
 namespace pag {
+/**
+ * The merged color stops of a GradientColor, which only depend on the gradient value and can be
+ * shared by all the frames that use the same value.
+ */
+struct GradientRamp {
+  std::vector<tgfx::Color> colors;
+  std::vector<float> positions;
+};
+
 /**
  * Defines attributes for drawing gradient colors.
  */
@@ -42,8 +51,7 @@ class GradientPaint {
   Enum gradientType = GradientFillType::Linear;
   tgfx::Point startPoint = tgfx::Point::Zero();
   tgfx::Point endPoint = tgfx::Point::Zero();
-  std::vector<tgfx::Color> colors;
-  std::vector<float> positions;
   tgfx::Matrix matrix = tgfx::Matrix::I();
+  std::shared_ptr<const GradientRamp> ramp = nullptr;
 };
 }  // namespace pag
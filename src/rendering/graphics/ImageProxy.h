@@ -56,6 +56,22 @@ class ImageProxy {
    */
   virtual std::shared_ptr<tgfx::Image> getImage(RenderCache* cache) const = 0;
 
+  /**
+   * Returns an image of the proxy for drawing at the specified scale factor. The returned image may
+   * be smaller than the original size, but it is never smaller than the scaled size. Returns the
+   * original image by default.
+   */
+  virtual std::shared_ptr<tgfx::Image> getScaledImage(RenderCache* cache, float) const {
+    return getImage(cache);
+  }
+
+  /**
+   * Releases the images returned by getScaledImage() that are kept in memory, it is usually called
+   * once they have been uploaded to the GPU.
+   */
+  virtual void releaseScaledImage() const {
+  }
+
  protected:
   virtual std::shared_ptr<tgfx::Image> makeImage(RenderCache* cache) const = 0;
 
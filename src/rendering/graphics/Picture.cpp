@@ -60,7 +60,7 @@ class ImageProxyPicture : public Picture {
     if (snapshot) {
       return snapshot->hitTest(cache, x, y);
     }
-    auto image = proxy->getImage(cache);
+    auto image = getDrawingImage(cache);
     if (image == nullptr) {
       return false;
     }
@@ -68,9 +68,10 @@ class ImageProxyPicture : public Picture {
     if (surface == nullptr) {
       return false;
     }
+    auto matrix = getDrawingMatrix(image.get());
     auto canvas = surface->getCanvas();
     canvas->setMatrix(tgfx::Matrix::MakeTrans(-x, -y));
-    canvas->drawImage(std::move(image));
+    canvas->drawImage(std::move(image), matrix);
     return surface->getColor(0, 0).alpha > 0;
   }
 
@@ -98,13 +99,37 @@ class ImageProxyPicture : public Picture {
         return;
       }
     }
-    auto image = proxy->getImage(cache);
-    canvas->drawImage(std::move(image));
+    auto image = getDrawingImage(cache);
+    if (image == nullptr) {
+      return;
+    }
+    auto matrix = getDrawingMatrix(image.get());
+    canvas->drawImage(std::move(image), matrix);
   }
 
  private:
   std::shared_ptr<ImageProxy> proxy = nullptr;
 
+  /**
+   * Returns the image to draw when there is no snapshot, such as when the snapshots are disabled or
+   * the graphics memory is running out. It is decoded at the displayed size if that is smaller than
+   * the original size, the same as the snapshots, so that the full size image is never decoded on
+   * the render thread.
+   */
+  std::shared_ptr<tgfx::Image> getDrawingImage(RenderCache* cache) const {
+    auto maxScaleFactor = cache->getAssetMaxScale(assetID);
+    if (maxScaleFactor <= 0) {
+      return proxy->getImage(cache);
+    }
+    return proxy->getScaledImage(cache, getScaleFactor(maxScaleFactor));
+  }
+
+  tgfx::Matrix getDrawingMatrix(const tgfx::Image* image) const {
+    auto scaleX = static_cast<float>(proxy->width()) / static_cast<float>(image->width());
+    auto scaleY = static_cast<float>(proxy->height()) / static_cast<float>(image->height());
+    return tgfx::Matrix::MakeScale(scaleX, scaleY);
+  }
+
   float getScaleFactor(float maxScaleFactor) const override {
     // Use RescaleImage() only when the maxScaleFactor is less than 0.7f (half in memory size) to
     // avoid the unnecessary increase of draw calls.
@@ -117,20 +142,24 @@ class ImageProxyPicture : public Picture {
 
   std::unique_ptr<Snapshot> makeSnapshot(RenderCache* cache, float scaleFactor,
                                          bool mipmapped) const override {
-    auto image = proxy->getImage(cache);
+    auto image = proxy->getScaledImage(cache, scaleFactor);
     if (image == nullptr) {
       return nullptr;
     }
-    bool needRescale = !image->isTextureBacked() && scaleFactor != 1.0f;
+    // The proxy may return an image that has been decoded smaller than the original size.
+    auto imageScale = static_cast<float>(image->width()) / static_cast<float>(proxy->width());
+    bool needRescale = !image->isTextureBacked() && scaleFactor != imageScale;
     if (needRescale) {
-      image = RescaleImage(cache->getContext(), image, scaleFactor, mipmapped);
+      image = RescaleImage(cache->getContext(), image, scaleFactor / imageScale, mipmapped);
     } else {
       image = image->makeTextureImage(cache->getContext());
-      scaleFactor = 1.0f;
+      scaleFactor = imageScale;
     }
     if (image == nullptr) {
       return nullptr;
     }
+    // The pixels have been uploaded to the GPU, the decoded copy in memory is no longer needed.
+    proxy->releaseScaledImage();
     auto snapshot = new Snapshot(image, tgfx::Matrix::MakeScale(1 / scaleFactor));
     return std::unique_ptr<Snapshot>(snapshot);
   }
@@ -142,8 +171,8 @@ class ImageProxyPicture : public Picture {
 //====================================== SnapshotPicture ===========================================
 class SnapshotPicture : public Picture {
  public:
-  SnapshotPicture(ID assetID, std::shared_ptr<Graphic> graphic)
-      : Picture(assetID), graphic(std::move(graphic)) {
+  SnapshotPicture(ID assetID, std::shared_ptr<Graphic> graphic, bool hasFilters)
+      : Picture(assetID), graphic(std::move(graphic)), hasFilters(hasFilters) {
   }
 
   void measureBounds(tgfx::Rect* bounds) const override {
@@ -186,6 +215,10 @@ class SnapshotPicture : public Picture {
     return maxScaleFactor;
   }
 
+  bool dependsOnFilterQuality() const override {
+    return hasFilters;
+  }
+
   std::unique_ptr<Snapshot> makeSnapshot(RenderCache* cache, float scaleFactor,
                                          bool mipmapped) const override {
     tgfx::Rect bounds = tgfx::Rect::MakeEmpty();
@@ -212,6 +245,7 @@ class SnapshotPicture : public Picture {
 
  private:
   std::shared_ptr<Graphic> graphic = nullptr;
+  bool hasFilters = false;
 };
 //===================================== SnapshotPicture ============================================
 
@@ -337,10 +371,11 @@ std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, const tgfx::BackendTextur
   return std::make_shared<ImageProxyPicture>(assetID, proxy);
 }
 
-std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic) {
+std::shared_ptr<Graphic> Picture::MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic,
+                                           bool hasFilters) {
   if (assetID == 0 || graphic == nullptr || graphic->type() == GraphicType::Picture) {
     return graphic;
   }
-  return std::make_shared<SnapshotPicture>(assetID, graphic);
+  return std::make_shared<SnapshotPicture>(assetID, graphic, hasFilters);
 }
 }  // namespace pag
@@ -55,9 +55,11 @@ class Picture : public Graphic {
   /**
    * Creates a new Picture with specified graphic. If the assetID is valid (not 0), the returned
    * Picture may be cached as an internal texture representation during rendering, which increases
-   * performance for drawing complex content.
+   * performance for drawing complex content. Set hasFilters to true if the graphic contains the
+   * output of filters, whose cache is made again once the filter quality level changes.
    */
-  static std::shared_ptr<Graphic> MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic);
+  static std::shared_ptr<Graphic> MakeFrom(ID assetID, std::shared_ptr<Graphic> graphic,
+                                           bool hasFilters = false);
 
   explicit Picture(ID assetID);
 
@@ -69,6 +71,15 @@ class Picture : public Graphic {
   ID assetID = 0;
 
   virtual float getScaleFactor(float maxScaleFactor) const = 0;
+
+  /**
+   * Returns true if the content may be rendered by filters, whose output changes with the filter
+   * quality level.
+   */
+  virtual bool dependsOnFilterQuality() const {
+    return false;
+  }
+
   virtual std::unique_ptr<Snapshot> makeSnapshot(RenderCache* cache, float scaleFactor,
                                                  bool mipmapped) const = 0;
 
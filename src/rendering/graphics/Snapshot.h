@@ -70,6 +70,7 @@ class Snapshot {
   tgfx::Matrix matrix = tgfx::Matrix::I();
   ID assetID = 0;
   uint64_t makerKey = 0;
+  uint32_t qualityVersion = 0;
   Frame idleFrames = 0;
 
   friend class RenderCache;
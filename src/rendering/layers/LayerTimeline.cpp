@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "LayerTimeline.h"
+#include <algorithm>
+#include "base/utils/TimeUtil.h"
+
+namespace pag {
+const std::vector<PAGLayer*>& LayerTimeline::getLayersToVisit(
+    const std::vector<std::shared_ptr<PAGLayer>>& layers, int64_t layerTime) {
+  layersToVisit.clear();
+  if (!valid) {
+    rebuild(layers, layerTime);
+    for (auto& layer : layers) {
+      if (!layer->_excludedFromTimeline) {
+        layersToVisit.push_back(layer.get());
+      }
+    }
+    markVisitedLayers();
+    return layersToVisit;
+  }
+  layersToVisit = untrackedLayers;
+  // The layers active at the previous time are always visited, they either stay active or just
+  // crossed one of their boundaries.
+  std::vector<Entry> newActiveEntries = {};
+  for (auto& entry : activeEntries) {
+    layersToVisit.push_back(entry.layer);
+    if (entry.contains(layerTime)) {
+      newActiveEntries.push_back(entry);
+    }
+  }
+  if (layerTime > lastTime) {
+    // The layers that start in (lastTime, layerTime] and are still active.
+    auto compareStart = [](int64_t time, const Entry& entry) { return time < entry.startTime; };
+    auto begin = std::upper_bound(entriesByStart.begin(), entriesByStart.end(), lastTime,
+                                  compareStart);
+    auto end = std::upper_bound(begin, entriesByStart.end(), layerTime, compareStart);
+    for (auto iter = begin; iter != end; iter++) {
+      if (iter->contains(layerTime)) {
+        layersToVisit.push_back(iter->layer);
+        newActiveEntries.push_back(*iter);
+      }
+    }
+  } else if (layerTime < lastTime) {
+    // The layers that end in (layerTime, lastTime] and are active again.
+    auto compareEnd = [](int64_t time, const Entry& entry) { return time < entry.endTime; };
+    auto begin =
+        std::upper_bound(entriesByEnd.begin(), entriesByEnd.end(), layerTime, compareEnd);
+    auto end = std::upper_bound(begin, entriesByEnd.end(), lastTime, compareEnd);
+    for (auto iter = begin; iter != end; iter++) {
+      if (iter->contains(layerTime)) {
+        layersToVisit.push_back(iter->layer);
+        newActiveEntries.push_back(*iter);
+      }
+    }
+  }
+  activeEntries = std::move(newActiveEntries);
+  lastTime = layerTime;
+  markVisitedLayers();
+  return layersToVisit;
+}
+
+void LayerTimeline::markVisitedLayers() {
+  visitedLayers.clear();
+  visitedLayers.insert(layersToVisit.begin(), layersToVisit.end());
+}
+
+void LayerTimeline::rebuild(const std::vector<std::shared_ptr<PAGLayer>>& layers,
+                            int64_t layerTime) {
+  entriesByStart.clear();
+  activeEntries.clear();
+  untrackedLayers.clear();
+  for (auto& layer : layers) {
+    if (layer->_excludedFromTimeline) {
+      continue;
+    }
+    if (layer->layerType() == LayerType::Image) {
+      // The replacement of an image layer may play its own content timeline.
+      untrackedLayers.push_back(layer.get());
+      continue;
+    }
+    auto frameRate = layer->frameRateInternal();
+    auto startFrame = layer->startFrame;
+    auto endFrame = startFrame + layer->stretchedFrameDuration();
+    // Extends one frame on both sides to absorb the rounding of time-frame conversions.
+    Entry entry = {layer.get(), FrameToTime(startFrame - 1, frameRate),
+                   FrameToTime(endFrame + 1, frameRate)};
+    entriesByStart.push_back(entry);
+    if (entry.contains(layerTime)) {
+      activeEntries.push_back(entry);
+    }
+  }
+  entriesByEnd = entriesByStart;
+  std::sort(entriesByStart.begin(), entriesByStart.end(),
+            [](const Entry& a, const Entry& b) { return a.startTime < b.startTime; });
+  std::sort(entriesByEnd.begin(), entriesByEnd.end(),
+            [](const Entry& a, const Entry& b) { return a.endTime < b.endTime; });
+  lastTime = layerTime;
+  valid = true;
+}
+}  // namespace pag
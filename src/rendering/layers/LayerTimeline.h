@@ -0,0 +1,97 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <unordered_set>
+#include "pag/pag.h"
+
+namespace pag {
+/**
+ * LayerTimeline indexes the visible ranges of the child layers of a composition, so that moving
+ * the composition to a new time only visits the children that are active at the new time or were
+ * active at the previous one. Children that stay outside of their visible ranges on both sides are
+ * skipped, together with their whole subtrees. The set of active children is updated
+ * incrementally as the time moves, by sweeping the ranges that start or end in between.
+ */
+class LayerTimeline {
+ public:
+  /**
+   * Marks the index as stale. The next call to getLayersToVisit() returns all the children and
+   * rebuilds the index.
+   */
+  void invalidate() {
+    valid = false;
+  }
+
+  /**
+   * Returns the child layers that need to go to the specified time.
+   */
+  const std::vector<PAGLayer*>& getLayersToVisit(
+      const std::vector<std::shared_ptr<PAGLayer>>& layers, int64_t layerTime);
+
+  /**
+   * Returns the time passed to the last getLayersToVisit() call.
+   */
+  int64_t currentTime() const {
+    return lastTime;
+  }
+
+  /**
+   * Returns true if the child layer was not visited by the last getLayersToVisit() call, which
+   * means its own time is out of date and it should be at currentTime() instead. The layers
+   * excluded from the timeline keep their own times.
+   */
+  bool isSkipped(const PAGLayer* layer) const {
+    return !layer->_excludedFromTimeline && visitedLayers.count(layer) == 0;
+  }
+
+  /**
+   * Marks the child layer as being in sync with the timeline, e.g. after its time is set directly.
+   */
+  void markVisited(const PAGLayer* layer) {
+    visitedLayers.insert(layer);
+  }
+
+ private:
+  struct Entry {
+    PAGLayer* layer = nullptr;
+    int64_t startTime = 0;
+    int64_t endTime = 0;
+
+    bool contains(int64_t time) const {
+      return startTime <= time && time < endTime;
+    }
+  };
+
+  bool valid = false;
+  int64_t lastTime = 0;
+  std::vector<Entry> entriesByStart = {};
+  std::vector<Entry> entriesByEnd = {};
+  std::vector<Entry> activeEntries = {};
+  // Layers whose visible ranges can not be derived from their own timelines, always visited.
+  std::vector<PAGLayer*> untrackedLayers = {};
+  std::vector<PAGLayer*> layersToVisit = {};
+  // The layers moved along with the timeline by the last getLayersToVisit() call, or marked as
+  // visited since then.
+  std::unordered_set<const PAGLayer*> visitedLayers = {};
+
+  void rebuild(const std::vector<std::shared_ptr<PAGLayer>>& layers, int64_t layerTime);
+  void markVisitedLayers();
+};
+}  // namespace pag
@@ -24,6 +24,7 @@
 #include "rendering/caches/LayerCache.h"
 #include "rendering/caches/RenderCache.h"
 #include "rendering/graphics/Recorder.h"
+#include "rendering/layers/LayerTimeline.h"
 #include "rendering/layers/PAGStage.h"
 #include "rendering/renderers/LayerRenderer.h"
 #include "rendering/utils/LockGuard.h"
@@ -66,6 +67,7 @@ PAGComposition::~PAGComposition() {
     delete emptyComposition;  // created by PAGComposition(width, height).
     delete layer;             // created by PAGComposition(width, height).
   }
+  delete timeline;
 }
 
 int PAGComposition::width() const {
@@ -204,6 +206,11 @@ bool PAGComposition::doAddLayer(std::shared_ptr<PAGLayer> pagLayer, int index) {
   }
   this->layers.insert(this->layers.begin() + index, pagLayer);
   pagLayer->_parent = this;
+  invalidateTimeline();
+  if (timeline != nullptr) {
+    // The new child keeps its own time until this composition moves again.
+    timeline->markVisited(pagLayer.get());
+  }
   notifyModified(true);
   if (emptyComposition) {
     updateDurationAndFrameRate();
@@ -256,6 +263,7 @@ std::shared_ptr<PAGLayer> PAGComposition::doRemoveLayer(int index) {
   layer->detachFromTree();
   layer->_parent = nullptr;
   layers.erase(layers.begin() + index);
+  invalidateTimeline();
   notifyModified(true);
   if (emptyComposition) {
     updateDurationAndFrameRate();
@@ -379,6 +387,21 @@ float PAGComposition::frameRateInternal() const {
 
 bool PAGComposition::gotoTime(int64_t layerTime) {
   auto changed = PAGLayer::gotoTime(layerTime);
+  if (timeline == nullptr) {
+    timeline = new LayerTimeline();
+  }
+  // 只有在当前时间或上一次时间处于可见范围内的子图层需要跳转，其余子图层前后都不可见，可以整体跳过。
+  auto childTime = layerTime - childTimeOffset();
+  for (auto layer : timeline->getLayersToVisit(layers, childTime)) {
+    if (layer->gotoTime(childTime)) {
+      layer->invalidateRetainedCaches();
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+int64_t PAGComposition::childTimeOffset() const {
   auto compositionOffset =
       static_cast<PreComposeLayer*>(layer)->compositionStartTime - layer->startTime + startFrame;
   /// 这里用floor取帧数是为了防止compositionOffsetTime变大导致layerTime变小导致显示帧数不正确。
@@ -386,17 +409,25 @@ bool PAGComposition::gotoTime(int64_t layerTime) {
   /// 此时如果取ceil compositionOffsetTime = 33334， subLayerTime = 66666，subLayerFrame = 1.9998
   /// 即显示第1帧， 但纯用frame计算时，gotoFrame = 2，因此此时不能取ceil，而要取floor来保证
   /// layerTime时间足够
-  auto compositionOffsetTime =
-      static_cast<Frame>(floor(compositionOffset * 1000000.0 / frameRateInternal()));
-  for (auto& layer : layers) {
-    if (layer->_excludedFromTimeline) {
-      continue;
-    }
-    if (layer->gotoTime(layerTime - compositionOffsetTime)) {
-      changed = true;
-    }
+  return static_cast<Frame>(floor(compositionOffset * 1000000.0 / frameRateInternal()));
+}
+
+int64_t PAGComposition::getChildTime(int64_t layerTime) const {
+  return layerTime - childTimeOffset();
+}
+
+bool PAGComposition::getSkippedChildTime(const PAGLayer* child, int64_t* childTime) const {
+  int64_t layerTime = 0;
+  if (getSkippedTime(&layerTime)) {
+    // This composition is skipped as well, so none of its children are up to date.
+    *childTime = getChildTime(layerTime);
+    return true;
   }
-  return changed;
+  if (timeline != nullptr && timeline->isSkipped(child)) {
+    *childTime = timeline->currentTime();
+    return true;
+  }
+  return false;
 }
 
 void PAGComposition::draw(Recorder* recorder) {
@@ -424,6 +455,10 @@ void PAGComposition::draw(Recorder* recorder) {
   for (int i = 0; i < count; i++) {
     auto& childLayer = layers[i];
     if (!childLayer->layerVisible) {
+      // 不可见的图层不再保留录制结果，避免长期占用内存。
+      if (stage != nullptr) {
+        stage->removeRetainedGraphic(childLayer.get());
+      }
       continue;
     }
     DrawChildLayer(recorder, childLayer.get());
@@ -434,12 +469,23 @@ void PAGComposition::draw(Recorder* recorder) {
 }
 
 void PAGComposition::DrawChildLayer(Recorder* recorder, PAGLayer* childLayer) {
-  auto filterModifier = childLayer->cacheFilters() ? nullptr : FilterModifier::Make(childLayer);
-  auto trackMatte = TrackMatteRenderer::Make(childLayer);
-  Transform extraTransform = {ToTGFX(childLayer->layerMatrix), childLayer->layerAlpha};
-  LayerRenderer::DrawLayer(recorder, childLayer->layer,
-                           childLayer->contentFrame + childLayer->layer->startTime, filterModifier,
-                           trackMatte.get(), childLayer, &extraTransform);
+  auto stage = childLayer->stage;
+  // 只有自身或子项发生变化的图层才需要重新录制，其余图层直接复用上一次录制的结果。
+  auto graphic = stage ? stage->getRetainedGraphic(childLayer) : nullptr;
+  if (graphic == nullptr) {
+    auto filterModifier = childLayer->cacheFilters() ? nullptr : FilterModifier::Make(childLayer);
+    auto trackMatte = TrackMatteRenderer::Make(childLayer);
+    Transform extraTransform = {ToTGFX(childLayer->layerMatrix), childLayer->layerAlpha};
+    Recorder layerRecorder = {};
+    LayerRenderer::DrawLayer(&layerRecorder, childLayer->layer,
+                             childLayer->contentFrame + childLayer->layer->startTime,
+                             filterModifier, trackMatte.get(), childLayer, &extraTransform);
+    graphic = layerRecorder.makeGraphic();
+    if (stage != nullptr) {
+      stage->setRetainedGraphic(childLayer, graphic);
+    }
+  }
+  recorder->drawGraphic(graphic);
 }
 
 void PAGComposition::measureBounds(tgfx::Rect* bounds) {
@@ -561,6 +607,53 @@ bool PAGComposition::GetChildLayerAtPoint(PAGLayer* childLayer, float x, float y
   return success;
 }
 
+void PAGComposition::MeasureChildHitBounds(tgfx::Rect* bounds, PAGLayer* childLayer) {
+  auto stage = childLayer->stage;
+  if (stage != nullptr && stage->getHitBounds(childLayer, bounds)) {
+    return;
+  }
+  // The hit bounds must enclose everything GetChildLayerAtPoint() may report, including the
+  // descendants and their track matte layers, which could lie outside the content bounds.
+  bounds->setEmpty();
+  Transform layerTransform = {};
+  if (childLayer->getTransform(&layerTransform)) {
+    childLayer->measureBounds(bounds);
+    if (childLayer->layerType() == LayerType::PreCompose) {
+      auto composition = static_cast<PAGComposition*>(childLayer);
+      for (auto& layer : composition->layers) {
+        if (!layer->layerVisible) {
+          continue;
+        }
+        tgfx::Rect layerBounds = {};
+        MeasureChildHitBounds(&layerBounds, layer.get());
+        bounds->join(layerBounds);
+        Transform trackMatteTransform = {};
+        if (layer->_trackMatteLayer &&
+            layer->_trackMatteLayer->getTransform(&trackMatteTransform)) {
+          tgfx::Rect trackMatteBounds = {};
+          layer->_trackMatteLayer->measureBounds(&trackMatteBounds);
+          trackMatteTransform.matrix.mapRect(&trackMatteBounds);
+          bounds->join(trackMatteBounds);
+        }
+      }
+      if (composition->hasClip()) {
+        auto clipBounds = tgfx::Rect::MakeWH(composition->_width, composition->_height);
+        if (!bounds->intersect(clipBounds)) {
+          bounds->setEmpty();
+        }
+      }
+    }
+    auto mask = childLayer->layerCache->getMasks(childLayer->contentFrame);
+    if (mask && !mask->isInverseFillType() && !bounds->intersect(mask->getBounds())) {
+      bounds->setEmpty();
+    }
+    layerTransform.matrix.mapRect(bounds);
+  }
+  if (stage != nullptr) {
+    stage->setHitBounds(childLayer, *bounds);
+  }
+}
+
 bool PAGComposition::getLayersUnderPointInternal(float x, float y,
                                                  std::vector<std::shared_ptr<PAGLayer>>* results) {
   auto bounds = tgfx::Rect::MakeWH(_width, _height);
@@ -577,6 +670,11 @@ bool PAGComposition::getLayersUnderPointInternal(float x, float y,
         !GetTrackMatteLayerAtPoint(childLayer.get(), x, y, results)) {
       continue;
     }
+    tgfx::Rect hitBounds = {};
+    MeasureChildHitBounds(&hitBounds, childLayer.get());
+    if (!hitBounds.contains(x, y)) {
+      continue;
+    }
     auto success = GetChildLayerAtPoint(childLayer.get(), x, y, results);
     if (success) {
       results->push_back(childLayer);
@@ -675,8 +773,17 @@ void PAGComposition::updateDurationAndFrameRate() {
     _frameRate = layerMaxFrameRate;
     changed = true;
   }
-  if (changed && _parent && _parent->emptyComposition) {
-    _parent->updateDurationAndFrameRate();
+  if (changed && _parent) {
+    _parent->invalidateTimeline();
+    if (_parent->emptyComposition) {
+      _parent->updateDurationAndFrameRate();
+    }
+  }
+}
+
+void PAGComposition::invalidateTimeline() {
+  if (timeline != nullptr) {
+    timeline->invalidate();
   }
 }
 }  // namespace pag
@@ -19,6 +19,7 @@
 #include "base/utils/TimeUtil.h"
 #include "pag/file.h"
 #include "pag/pag.h"
+#include "rendering/caches/FileSnapshot.h"
 #include "rendering/utils/LockGuard.h"
 #include "rendering/utils/ScopedLock.h"
 
@@ -29,13 +30,16 @@ uint16_t PAGFile::MaxSupportedTagLevel() {
 
 std::shared_ptr<PAGFile> PAGFile::Load(const void* bytes, size_t length,
                                        const std::string& filePath, const std::string& password) {
-  auto file = File::Load(bytes, length, filePath, password);
+  auto file = FileSnapshot::LoadFile(bytes, length, filePath, password);
   return MakeFrom(file);
 }
 
 std::shared_ptr<PAGFile> PAGFile::Load(const std::string& filePath, const std::string& password) {
-  auto file = File::Load(filePath, password);
-  return MakeFrom(file);
+  auto byteData = ByteData::FromPath(filePath);
+  if (byteData == nullptr) {
+    return nullptr;
+  }
+  return Load(byteData->data(), byteData->length(), filePath, password);
 }
 
 std::shared_ptr<PAGFile> PAGFile::MakeFrom(std::shared_ptr<File> file) {
@@ -196,6 +200,9 @@ void PAGFile::setDurationInternal(int64_t duration) {
     return;
   }
   _stretchedFrameDuration = totalFrames;
+  if (_parent) {
+    _parent->invalidateTimeline();
+  }
   if (_parent && _parent->emptyComposition) {
     _parent->updateDurationAndFrameRate();
   }
@@ -255,6 +262,13 @@ bool PAGFile::gotoTime(int64_t layerTime) {
   return PAGComposition::gotoTime(fileTime);
 }
 
+int64_t PAGFile::getChildTime(int64_t layerTime) const {
+  if (_stretchedFrameDuration != layer->duration) {
+    layerTime = stretchedTimeToFileTime(layerTime);
+  }
+  return PAGComposition::getChildTime(layerTime);
+}
+
 Frame PAGFile::childFrameToLocal(pag::Frame childFrame, float childFrameRate) const {
   childFrame = PAGComposition::childFrameToLocal(childFrame, childFrameRate);
   if (_stretchedFrameDuration != layer->duration) {
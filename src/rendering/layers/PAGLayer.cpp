@@ -22,6 +22,7 @@
 #include "pag/pag.h"
 #include "rendering/caches/LayerCache.h"
 #include "rendering/caches/RenderCache.h"
+#include "rendering/layers/LayerTimeline.h"
 #include "rendering/layers/PAGStage.h"
 #include "rendering/renderers/TrackMatteRenderer.h"
 #include "rendering/utils/LockGuard.h"
@@ -236,8 +237,13 @@ void PAGLayer::setStartTimeInternal(int64_t time) {
   if (startFrame == targetStartFrame) {
     return;
   }
-  auto layerFrame = startFrame + contentFrame;
+  int64_t layerTime = 0;
+  auto layerFrame = getSkippedTime(&layerTime) ? TimeToFrame(layerTime, frameRateInternal())
+                                                : startFrame + contentFrame;
   startFrame = targetStartFrame;
+  if (_parent) {
+    _parent->invalidateTimeline();
+  }
   if (_parent && _parent->emptyComposition) {
     _parent->updateDurationAndFrameRate();
   }
@@ -278,20 +284,39 @@ void PAGLayer::setCurrentTime(int64_t time) {
 }
 
 bool PAGLayer::setCurrentTimeInternal(int64_t time) {
+  if (_parent) {
+    // The time of a child is now out of sync with its parent, revisit all children next time.
+    _parent->invalidateTimeline();
+    if (_parent->timeline != nullptr) {
+      _parent->timeline->markVisited(this);
+    }
+  }
   return gotoTimeAndNotifyChanged(time);
 }
 
 Frame PAGLayer::currentFrameInternal() const {
+  int64_t layerTime = 0;
+  if (getSkippedTime(&layerTime)) {
+    // The layer stays out of its visible range, so its parent skipped it and its content frame is
+    // out of date.
+    return TimeToFrame(layerTime, frameRateInternal());
+  }
   return startFrame + stretchedContentFrame();
 }
 
+bool PAGLayer::getSkippedTime(int64_t* layerTime) const {
+  // A track matte layer moves along with its owner.
+  auto child = _parent == nullptr && trackMatteOwner != nullptr ? trackMatteOwner : this;
+  return child->_parent != nullptr && child->_parent->getSkippedChildTime(child, layerTime);
+}
+
 double PAGLayer::getProgress() {
   LockGuard autoLock(rootLocker);
   return getProgressInternal();
 }
 
 double PAGLayer::getProgressInternal() {
-  return FrameToProgress(stretchedContentFrame(), stretchedFrameDuration());
+  return FrameToProgress(currentFrameInternal() - startFrame, stretchedFrameDuration());
 }
 
 void PAGLayer::setProgress(double percent) {
@@ -313,7 +338,7 @@ void PAGLayer::preFrameInternal() {
   if (totalFrames <= 1) {
     return;
   }
-  auto targetContentFrame = stretchedContentFrame();
+  auto targetContentFrame = currentFrameInternal() - startFrame;
   targetContentFrame--;
   if (targetContentFrame < 0) {
     targetContentFrame = totalFrames - 1;
@@ -331,7 +356,7 @@ void PAGLayer::nextFrameInternal() {
   if (totalFrames <= 1) {
     return;
   }
-  auto targetContentFrame = stretchedContentFrame();
+  auto targetContentFrame = currentFrameInternal() - startFrame;
   targetContentFrame++;
   if (targetContentFrame >= totalFrames) {
     targetContentFrame = 0;
@@ -384,19 +409,31 @@ bool PAGLayer::excludedFromTimeline() const {
 void PAGLayer::setExcludedFromTimeline(bool value) {
   LockGuard autoLock(rootLocker);
   _excludedFromTimeline = value;
+  if (_parent) {
+    _parent->invalidateTimeline();
+  }
 }
 
 void PAGLayer::notifyModified(bool contentChanged) {
   if (contentChanged) {
     contentVersion++;
   }
+  invalidateRetainedCaches();
   auto parentLayer = getParentOrOwner();
   while (parentLayer) {
     parentLayer->contentVersion++;
+    parentLayer->invalidateRetainedCaches();
     parentLayer = parentLayer->getParentOrOwner();
   }
 }
 
+void PAGLayer::invalidateRetainedCaches() {
+  if (stage != nullptr) {
+    stage->removeRetainedGraphic(this);
+    stage->removeHitTestCache(this);
+  }
+}
+
 void PAGLayer::notifyAudioModified() {
   audioVersion++;
   auto parentLayer = getParentOrOwner();
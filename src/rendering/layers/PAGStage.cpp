@@ -96,9 +96,20 @@ void PAGStage::addReference(PAGLayer* pagLayer) {
   for (auto& effect : targetLayer->effects) {
     addToReferenceMap(effect->uniqueID, pagLayer);
   }
+  auto featherMaskID = GetFeatherMaskID(targetLayer);
+  if (featherMaskID != 0) {
+    addToReferenceMap(featherMaskID, pagLayer);
+  }
   invalidateCacheScale(pagLayer);
 }
 
+ID PAGStage::GetFeatherMaskID(Layer* layer) {
+  if (layer->masks.empty()) {
+    return 0;
+  }
+  return LayerCache::Get(layer)->getFeatherMaskID();
+}
+
 void PAGStage::addToReferenceMap(ID uniqueID, PAGLayer* pagLayer) {
   auto& layers = layerReferenceMap[uniqueID];
   auto position = std::find(layers.begin(), layers.end(), pagLayer);
@@ -110,6 +121,8 @@ void PAGStage::addToReferenceMap(ID uniqueID, PAGLayer* pagLayer) {
 void PAGStage::removeReference(PAGLayer* pagLayer) {
   // 重置 rootVersion，防止 rootComposition 被移除又加入一个 version 相同的其他 Composition。
   rootVersion = -1;
+  retainedGraphics.erase(pagLayer->uniqueID());
+  hitTestCaches.erase(pagLayer->uniqueID());
   removeFromReferenceMap(pagLayer->uniqueID(), pagLayer);
   removeFromReferenceMap(pagLayer->layer->uniqueID, pagLayer);
   if (pagLayer->layerType() == LayerType::PreCompose) {
@@ -133,6 +146,10 @@ void PAGStage::removeReference(PAGLayer* pagLayer) {
   for (auto& effect : targetLayer->effects) {
     removeFromReferenceMap(effect->uniqueID, pagLayer);
   }
+  auto featherMaskID = GetFeatherMaskID(targetLayer);
+  if (featherMaskID != 0) {
+    removeFromReferenceMap(featherMaskID, pagLayer);
+  }
   invalidateCacheScale(pagLayer);
 }
 
@@ -204,6 +221,95 @@ std::shared_ptr<Graphic> PAGStage::getSequenceGraphic(Composition* composition,
   return cache.graphic;
 }
 
+std::shared_ptr<Graphic> PAGStage::getRetainedGraphic(PAGLayer* pagLayer) {
+  auto result = retainedGraphics.find(pagLayer->uniqueID());
+  if (result == retainedGraphics.end()) {
+    return nullptr;
+  }
+  auto& cache = result->second;
+  if (cache.cacheFilters != pagLayer->cacheFilters()) {
+    retainedGraphics.erase(result);
+    return nullptr;
+  }
+  return cache.graphic;
+}
+
+void PAGStage::setRetainedGraphic(PAGLayer* pagLayer, std::shared_ptr<Graphic> graphic) {
+  if (graphic == nullptr) {
+    retainedGraphics.erase(pagLayer->uniqueID());
+    return;
+  }
+  RetainedGraphic cache = {};
+  cache.graphic = std::move(graphic);
+  cache.cacheFilters = pagLayer->cacheFilters();
+  cache.hasFilters = HasFilters(pagLayer);
+  retainedGraphics[pagLayer->uniqueID()] = std::move(cache);
+}
+
+void PAGStage::removeRetainedGraphic(PAGLayer* pagLayer) {
+  retainedGraphics.erase(pagLayer->uniqueID());
+}
+
+std::shared_ptr<Graphic> PAGStage::getHitTestGraphic(PAGLayer* pagLayer) {
+  auto result = hitTestCaches.find(pagLayer->uniqueID());
+  return result != hitTestCaches.end() ? result->second.graphic : nullptr;
+}
+
+void PAGStage::setHitTestGraphic(PAGLayer* pagLayer, std::shared_ptr<Graphic> graphic) {
+  hitTestCaches[pagLayer->uniqueID()].graphic = std::move(graphic);
+}
+
+bool PAGStage::getHitBounds(PAGLayer* pagLayer, tgfx::Rect* bounds) {
+  auto result = hitTestCaches.find(pagLayer->uniqueID());
+  if (result == hitTestCaches.end() || !result->second.hasHitBounds) {
+    return false;
+  }
+  *bounds = result->second.hitBounds;
+  return true;
+}
+
+void PAGStage::setHitBounds(PAGLayer* pagLayer, const tgfx::Rect& bounds) {
+  auto& cache = hitTestCaches[pagLayer->uniqueID()];
+  cache.hitBounds = bounds;
+  cache.hasHitBounds = true;
+}
+
+void PAGStage::removeHitTestCache(PAGLayer* pagLayer) {
+  hitTestCaches.erase(pagLayer->uniqueID());
+}
+
+void PAGStage::invalidateFilterGraphics() {
+  for (auto item = retainedGraphics.begin(); item != retainedGraphics.end();) {
+    if (item->second.hasFilters) {
+      item = retainedGraphics.erase(item);
+    } else {
+      item++;
+    }
+  }
+  // The hit test graphics are only kept until the next change, recording them again is cheap.
+  for (auto& item : hitTestCaches) {
+    item.second.graphic = nullptr;
+  }
+}
+
+bool PAGStage::HasFilters(PAGLayer* pagLayer) {
+  if (pagLayer->layerCache->hasFilters()) {
+    return true;
+  }
+  if (pagLayer->_trackMatteLayer != nullptr && HasFilters(pagLayer->_trackMatteLayer.get())) {
+    return true;
+  }
+  if (pagLayer->layerType() != LayerType::PreCompose) {
+    return false;
+  }
+  for (auto& childLayer : static_cast<PAGComposition*>(pagLayer)->layers) {
+    if (HasFilters(childLayer.get())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::map<int64_t, std::vector<PAGLayer*>> PAGStage::findNearlyVisibleLayersIn(
     int64_t timeDistance) {
   std::map<int64_t, std::vector<PAGLayer*>> distanceMap = {};
@@ -32,6 +32,21 @@ struct SequenceCache {
   Frame compositionFrame = 0;
 };
 
+struct RetainedGraphic {
+  std::shared_ptr<Graphic> graphic = nullptr;
+  bool cacheFilters = false;
+  bool hasFilters = false;
+};
+
+struct HitTestCache {
+  // The content of the PAGLayer recorded for pixel hit tests, in its own coordinates.
+  std::shared_ptr<Graphic> graphic = nullptr;
+  // The bounds in parent's coordinates enclosing every point where the PAGLayer or any of its
+  // descendants can be hit, which lets getLayersUnderPoint() skip the whole subtree quickly.
+  tgfx::Rect hitBounds = {};
+  bool hasHitBounds = false;
+};
+
 class PAGStage : public PAGComposition {
  public:
   static std::shared_ptr<PAGStage> Make(int width, int height);
@@ -90,6 +105,53 @@ class PAGStage : public PAGComposition {
 
   std::shared_ptr<Graphic> getSequenceGraphic(Composition* composition, Frame compositionFrame);
 
+  /**
+   * Returns the graphic recorded for the PAGLayer by its parent composition, or nullptr if the
+   * PAGLayer has changed since then, or the recorded graphic no longer matches the render states.
+   */
+  std::shared_ptr<Graphic> getRetainedGraphic(PAGLayer* pagLayer);
+
+  /**
+   * Keeps the graphic recorded for the PAGLayer by its parent composition until the PAGLayer or any
+   * of its descendants changes.
+   */
+  void setRetainedGraphic(PAGLayer* pagLayer, std::shared_ptr<Graphic> graphic);
+
+  /**
+   * Discards the graphic recorded for the PAGLayer.
+   */
+  void removeRetainedGraphic(PAGLayer* pagLayer);
+
+  /**
+   * Returns the content graphic recorded for hit testing the PAGLayer, or nullptr if the PAGLayer
+   * or any of its descendants has changed since then.
+   */
+  std::shared_ptr<Graphic> getHitTestGraphic(PAGLayer* pagLayer);
+
+  /**
+   * Keeps the content graphic recorded for hit testing the PAGLayer until the PAGLayer or any of
+   * its descendants changes.
+   */
+  void setHitTestGraphic(PAGLayer* pagLayer, std::shared_ptr<Graphic> graphic);
+
+  /**
+   * Returns false if the hit bounds of the PAGLayer are not measured since it last changed.
+   */
+  bool getHitBounds(PAGLayer* pagLayer, tgfx::Rect* bounds);
+
+  void setHitBounds(PAGLayer* pagLayer, const tgfx::Rect& bounds);
+
+  /**
+   * Discards the hit test graphic and the hit bounds of the PAGLayer.
+   */
+  void removeHitTestCache(PAGLayer* pagLayer);
+
+  /**
+   * Invalidates the graphics recorded for the PAGLayers that have filters in themselves or their
+   * descendants, it is called when the filter quality level changes.
+   */
+  void invalidateFilterGraphics();
+
   std::map<int64_t, std::vector<PAGLayer*>> findNearlyVisibleLayersIn(int64_t timeDistance);
 
   std::unordered_set<ID> getRemovedAssets();
@@ -114,10 +176,14 @@ class PAGStage : public PAGComposition {
   std::unordered_map<ID, std::vector<PAGLayer*>> layerReferenceMap = {};
   std::unordered_map<ID, std::pair<float, float>> scaleFactorCache = {};
   std::unordered_map<ID, SequenceCache> sequenceCache = {};
+  std::unordered_map<ID, RetainedGraphic> retainedGraphics = {};
+  std::unordered_map<ID, HitTestCache> hitTestCaches = {};
   std::unordered_set<ID> invalidAssets = {};
   std::unordered_map<ID, PAGImage*> pagImageMap = {};
 
   static tgfx::Point GetLayerContentScaleFactor(PAGLayer* pagLayer, bool isPAGImage);
+  static bool HasFilters(PAGLayer* pagLayer);
+  static ID GetFeatherMaskID(Layer* layer);
   PAGStage(int width, int height);
   pag::PAGLayer* getLayerFromReferenceMap(ID uniqueID);
   void addToReferenceMap(ID uniqueID, PAGLayer* pagLayer);
@@ -26,6 +26,23 @@
 #include "rendering/sequences/SequenceInfo.h"
 
 namespace pag {
+static bool HasFilters(VectorComposition* composition) {
+  for (auto layer : composition->layers) {
+    if (LayerCache::Get(layer)->hasFilters()) {
+      return true;
+    }
+    if (layer->type() != LayerType::PreCompose) {
+      continue;
+    }
+    auto subComposition = static_cast<PreComposeLayer*>(layer)->composition;
+    if (subComposition->type() == CompositionType::Vector &&
+        HasFilters(static_cast<VectorComposition*>(subComposition))) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::shared_ptr<Graphic> RenderVectorComposition(VectorComposition* composition,
                                                  Frame compositionFrame) {
   Recorder recorder = {};
@@ -49,7 +66,7 @@ std::shared_ptr<Graphic> RenderVectorComposition(VectorComposition* composition,
   auto graphic = recorder.makeGraphic();
   if (layers.size() > 1 && composition->staticContent() && !composition->hasImageContent()) {
     // 仅当子项列表只存在矢量内容并图层数量大于 1 时才包装一个 Image，避免重复的 Image 包装。
-    graphic = Picture::MakeFrom(composition->uniqueID, graphic);
+    graphic = Picture::MakeFrom(composition->uniqueID, graphic, HasFilters(composition));
   }
   return graphic;
 }
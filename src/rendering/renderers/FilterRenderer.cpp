@@ -24,6 +24,7 @@
 #include "rendering/filters/FilterModifier.h"
 #include "rendering/filters/LayerStylesFilter.h"
 #include "rendering/filters/MotionBlurFilter.h"
+#include "rendering/filters/Transform3DFilter.h"
 #include "rendering/filters/utils/Filter3DFactory.h"
 #include "rendering/filters/utils/FilterBuffer.h"
 #include "rendering/filters/utils/FilterHelper.h"
@@ -106,6 +107,10 @@ void TransformFilterBounds(tgfx::Rect* filterBounds, const FilterList* filterLis
     filterBounds->roundOut();
   }
 
+  if (filterList->layer->transform3D) {
+    Transform3DFilter::TransformBounds(filterBounds, filterList->layer, filterList->layerFrame);
+  }
+
   if (filterList->layer->motionBlur && !filterList->layer->transform3D) {
     MotionBlurFilter::TransformBounds(filterBounds, filterList->effectScale, filterList->layer,
                                       filterList->layerFrame);
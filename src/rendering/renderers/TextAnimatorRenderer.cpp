@@ -22,7 +22,7 @@
 namespace pag {
 
 // 判断是否包含动画
-static bool HasAnimator(const std::vector<TextAnimator*>* animators) {
+bool TextAnimatorRenderer::HasAnimator(const std::vector<TextAnimator*>* animators) {
   if (animators != nullptr) {
     for (auto animator : *animators) {
       auto typographyProperties = animator->typographyProperties;
@@ -71,6 +71,25 @@ static int CalculateCharactersCount(const std::vector<std::vector<GlyphHandle>>&
 bool TextAnimatorRenderer::ApplyToGlyphs(std::vector<std::vector<GlyphHandle>>& glyphList,
                                          const std::vector<TextAnimator*>* animators,
                                          Enum justification, Frame layerFrame) {
+  std::vector<GlyphTransform> transforms = {};
+  if (!ComputeGlyphTransforms(glyphList, animators, justification, layerFrame, &transforms)) {
+    return false;
+  }
+  size_t index = 0;
+  for (auto& line : glyphList) {
+    for (auto& glyph : line) {
+      auto& transform = transforms[index++];
+      glyph->setMatrix(transform.matrix);
+      glyph->setAlpha(transform.alpha);
+    }
+  }
+  return true;
+}
+
+bool TextAnimatorRenderer::ComputeGlyphTransforms(
+    const std::vector<std::vector<GlyphHandle>>& glyphList,
+    const std::vector<TextAnimator*>* animators, Enum justification, Frame layerFrame,
+    std::vector<GlyphTransform>* transforms) {
   if (!HasAnimator(animators)) {
     return false;  // 提前判断如果没有文本动画，就不必要进行下面一堆操作了。
   }
@@ -78,9 +97,16 @@ bool TextAnimatorRenderer::ApplyToGlyphs(std::vector<std::vector<GlyphHandle>>&
   if (count == 0) {
     return false;  // 如果字符数为0，则提前退出
   }
+  transforms->clear();
+  transforms->reserve(static_cast<size_t>(count));
+  for (auto& line : glyphList) {
+    for (auto& glyph : line) {
+      transforms->push_back({glyph->getMatrix(), glyph->getAlpha()});
+    }
+  }
   for (auto animator : *animators) {
     TextAnimatorRenderer animatorRenderer(animator, justification, count, layerFrame);
-    animatorRenderer.apply(glyphList);
+    animatorRenderer.apply(glyphList, transforms);
   }
   return true;
 }
@@ -174,16 +200,22 @@ void TextAnimatorRenderer::readTackingInfo(const TextAnimator* animator, Frame f
 }
 
 // 应用动画
-void TextAnimatorRenderer::apply(std::vector<std::vector<GlyphHandle>>& glyphList) {
+void TextAnimatorRenderer::apply(const std::vector<std::vector<GlyphHandle>>& glyphList,
+                                 std::vector<GlyphTransform>* transforms) {
+  // 先批量算出所有字符的范围因子，字间距长度和逐字符的变换都复用这一份结果。
+  std::vector<float> factors = {};
+  TextSelectorRenderer::CalculateFactorsFromSelectors(selectorRenderers, transforms->size(),
+                                                      &factors);
   int index = 0;
   for (auto& line : glyphList) {
     int lineIndex = index;
     int nextLineIndex = lineIndex + static_cast<int>(line.size());
-    auto trackingAnimatorLen = calculateTrackingLen(lineIndex, nextLineIndex);
+    auto trackingAnimatorLen = calculateTrackingLen(factors, lineIndex, nextLineIndex);
     auto offset = CalculateOffsetByJustification(justification, trackingAnimatorLen);
     for (auto& glyph : line) {
-      auto matrix = glyph->getMatrix();
-      auto factor = calculateFactorByIndex(index, nullptr);
+      auto& transform = (*transforms)[index];
+      auto matrix = transform.matrix;
+      auto factor = factors[index];
       // 字间距
       if (index > lineIndex) {  // 行首不加字间距的before部分
         offset += trackingBefore * factor;
@@ -204,21 +236,20 @@ void TextAnimatorRenderer::apply(std::vector<std::vector<GlyphHandle>>& glyphLis
       if (factor < 0.0f) {
         factor = 0.0f;  // 透明度的范围不能超过[0，1]，所以限制factor不能为负。
       }
-      auto oldAlpha = glyph->getAlpha();
       auto alphaFactor = (alpha - 1.0f) * factor + 1.0f;
-      glyph->setAlpha(oldAlpha * alphaFactor);
-
-      glyph->setMatrix(matrix);
+      transform.alpha *= alphaFactor;
+      transform.matrix = matrix;
       index++;
     }
   }
 }
 
 // 计算一行的字间距长度
-float TextAnimatorRenderer::calculateTrackingLen(size_t textStart, size_t textEnd) {
+float TextAnimatorRenderer::calculateTrackingLen(const std::vector<float>& factors,
+                                                 size_t textStart, size_t textEnd) {
   float animatorTrackingLen = 0.0f;
   for (size_t i = textStart; i < textEnd; i++) {
-    auto factor = calculateFactorByIndex(i, nullptr);
+    auto factor = factors[i];
     if (i > textStart) {  // 不计行首字母前面的间距
       animatorTrackingLen += trackingBefore * factor;
     }
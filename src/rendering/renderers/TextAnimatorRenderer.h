@@ -25,8 +25,22 @@
 
 namespace pag {
 
+// 文本动画作用后单个字符的矩阵和透明度
+struct GlyphTransform {
+  tgfx::Matrix matrix = tgfx::Matrix::I();
+  float alpha = 1.0f;
+};
+
 class TextAnimatorRenderer {
  public:
+  // 判断是否包含会影响字符的文本动画
+  static bool HasAnimator(const std::vector<TextAnimator*>* animators);
+  // 计算文本动画作用后每个字符的矩阵和透明度，按行展开成一维数组，不修改 glyphList 本身。
+  // 如果含有动画内容返回 true
+  static bool ComputeGlyphTransforms(const std::vector<std::vector<GlyphHandle>>& glyphList,
+                                     const std::vector<TextAnimator*>* animators,
+                                     Enum justification, Frame layerFrame,
+                                     std::vector<GlyphTransform>* transforms);
   // 应用动画到Glyphs, 如果含有动画内容返回 true
   static bool ApplyToGlyphs(std::vector<std::vector<GlyphHandle>>& glyphList,
                             const std::vector<TextAnimator*>* animators, Enum justification,
@@ -41,9 +55,10 @@ class TextAnimatorRenderer {
 
  private:
   // 应用文本动画
-  void apply(std::vector<std::vector<GlyphHandle>>& glyphList);
+  void apply(const std::vector<std::vector<GlyphHandle>>& glyphList,
+             std::vector<GlyphTransform>* transforms);
   // 计算一行的字间距总长度
-  float calculateTrackingLen(size_t textStart, size_t textEnd);
+  float calculateTrackingLen(const std::vector<float>& factors, size_t textStart, size_t textEnd);
   // 根据字符序号计算该字符的范围因子
   float calculateFactorByIndex(size_t index, bool* pBiasFlag);
   // 读取字间距信息
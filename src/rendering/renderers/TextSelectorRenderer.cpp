@@ -38,6 +38,26 @@ float TextSelectorRenderer::CalculateFactorFromSelectors(
   return totalFactor;
 }
 
+void TextSelectorRenderer::CalculateFactorsFromSelectors(
+    const std::vector<TextSelectorRenderer*>& selectorRenderers, size_t textCount,
+    std::vector<float>* factors) {
+  factors->assign(textCount, 1.0f);
+  if (selectorRenderers.empty() || textCount == 0) {
+    return;
+  }
+  std::vector<float> selectorFactors(textCount);
+  bool isFirstSelector = true;
+  for (auto selectorRenderer : selectorRenderers) {
+    selectorRenderer->calculateFactors(selectorFactors.data());
+    auto totalFactors = factors->data();
+    for (size_t i = 0; i < textCount; i++) {
+      totalFactors[i] =
+          selectorRenderer->overlayFactor(totalFactors[i], selectorFactors[i], isFirstSelector);
+    }
+    isFirstSelector = false;
+  }
+}
+
 static float OverlayFactorByMode(float oldFactor, float factor, Enum mode) {
   float newFactor;
   switch (mode) {
@@ -188,6 +208,29 @@ float WigglySelectorRenderer::calculateFactorByIndex(size_t index, bool* pBiasFl
   return factor;
 }
 
+// 批量计算摆动选择器中所有字符的范围因子
+void WigglySelectorRenderer::calculateFactors(float* factors) {
+  if (textCount == 0) {
+    return;
+  }
+  // 时间相关的部分对所有字符都相同，提到循环外计算。
+  auto temporalSeed = wigglesPerSecond / 2.0 * (frame + temporalPhase / 30.f) / 24.0f;
+  auto randomPart = randomSeed / 3.13f;
+  auto spatialScale = 13.73f * (1.0f - correlation);
+  auto spatialOffset = spatialPhase / 80.0f;
+  for (size_t index = 0; index < textCount; index++) {
+    auto spatialSeed = (spatialScale * index + spatialOffset) / 21.13f;
+    auto seed = (spatialSeed + temporalSeed + randomPart) * 2 * M_PI;
+    auto factor = cos(seed) * cos(seed / 7 + M_PI / 5);
+    if (factor < -1.0f) {
+      factor = -1.0f;
+    } else if (factor > 1.0f) {
+      factor = 1.0f;
+    }
+    factors[index] = (factor + 1.0f) / 2 * (maxAmount - minAmount) + minAmount;
+  }
+}
+
 // 读取范围选择器
 RangeSelectorRenderer::RangeSelectorRenderer(const TextRangeSelector* selector, size_t textCount,
                                              Frame frame)
@@ -479,4 +522,71 @@ float RangeSelectorRenderer::calculateFactorByIndex(size_t index, bool* pBiasFla
   calculateBiasFlag(pBiasFlag);
   return factor;
 }
-}  // namespace pag
\ No newline at end of file
+
+template <typename ShapeFunc>
+static void CalculateRangeFactors(float* factors, size_t textCount, const int* randomIndexs,
+                                  float amount, ShapeFunc calculateFactor) {
+  for (size_t i = 0; i < textCount; i++) {
+    auto index = randomIndexs != nullptr ? static_cast<size_t>(randomIndexs[i]) : i;
+    auto textStart = static_cast<float>(index) / textCount;
+    auto textEnd = static_cast<float>(index + 1) / textCount;
+    auto factor = calculateFactor(textStart, textEnd);
+    if (factor < 0.0f) {
+      factor = 0.0f;
+    } else if (factor > 1.0f) {
+      factor = 1.0f;
+    }
+    factors[i] = factor * amount;
+  }
+}
+
+// 批量计算所有字符的范围因子，形状的分支提到循环外，避免逐个字符的虚函数调用和分支判断
+void RangeSelectorRenderer::calculateFactors(float* factors) {
+  if (textCount == 0) {
+    return;
+  }
+  auto indexs = randomizeOrder ? randomIndexs.data() : nullptr;
+  auto start = rangeStart;
+  auto end = rangeEnd;
+  auto high = easeHigh;
+  auto low = easeLow;
+  switch (shape) {
+    case TextRangeSelectorShape::RampUp: {
+      auto calculateFactor = [=](float textStart, float textEnd) {
+        return CalculateRangeFactorRampUp(textStart, textEnd, start, end);
+      };
+      CalculateRangeFactors(factors, textCount, indexs, amount, calculateFactor);
+    } break;
+    case TextRangeSelectorShape::RampDown: {
+      auto calculateFactor = [=](float textStart, float textEnd) {
+        return CalculateRangeFactorRampDown(textStart, textEnd, start, end);
+      };
+      CalculateRangeFactors(factors, textCount, indexs, amount, calculateFactor);
+    } break;
+    case TextRangeSelectorShape::Triangle: {
+      auto calculateFactor = [=](float textStart, float textEnd) {
+        return CalculateRangeFactorTriangle(textStart, textEnd, start, end, high, low);
+      };
+      CalculateRangeFactors(factors, textCount, indexs, amount, calculateFactor);
+    } break;
+    case TextRangeSelectorShape::Round: {
+      auto calculateFactor = [=](float textStart, float textEnd) {
+        return CalculateRangeFactorRound(textStart, textEnd, start, end);
+      };
+      CalculateRangeFactors(factors, textCount, indexs, amount, calculateFactor);
+    } break;
+    case TextRangeSelectorShape::Smooth: {
+      auto calculateFactor = [=](float textStart, float textEnd) {
+        return CalculateRangeFactorSmooth(textStart, textEnd, start, end);
+      };
+      CalculateRangeFactors(factors, textCount, indexs, amount, calculateFactor);
+    } break;
+    default: {
+      auto calculateFactor = [=](float textStart, float textEnd) {
+        return CalculateFactorSquare(textStart, textEnd, start, end);
+      };
+      CalculateRangeFactors(factors, textCount, indexs, amount, calculateFactor);
+    } break;
+  }
+}
+}  // namespace pag
@@ -27,6 +27,10 @@ class TextSelectorRenderer {
   static float CalculateFactorFromSelectors(
       const std::vector<TextSelectorRenderer*>& selectorRenderers, size_t index,
       bool* pBiasFlag = nullptr);
+  // 批量计算所有字符叠加后的范围因子，结果与逐个调用 CalculateFactorFromSelectors 一致
+  static void CalculateFactorsFromSelectors(
+      const std::vector<TextSelectorRenderer*>& selectorRenderers, size_t textCount,
+      std::vector<float>* factors);
 
   TextSelectorRenderer(size_t textCount, Frame frame) : textCount(textCount), frame(frame) {
   }
@@ -45,6 +49,8 @@ class TextSelectorRenderer {
   void calculateRandomIndexs(uint16_t seed);
   // 计算某个字符的范围因子
   virtual float calculateFactorByIndex(size_t index, bool* pBiasFlag) = 0;
+  // 批量计算所有字符的范围因子，factors 的长度为 textCount
+  virtual void calculateFactors(float* factors) = 0;
 };
 
 class WigglySelectorRenderer : public TextSelectorRenderer {
@@ -55,6 +61,8 @@ class WigglySelectorRenderer : public TextSelectorRenderer {
  private:
   // 计算某个字符的范围因子
   float calculateFactorByIndex(size_t index, bool* pBiasFlag) override;
+  // 批量计算所有字符的范围因子
+  void calculateFactors(float* factors) override;
 
   // 摆动选择器参数：模式(在父类里)、最大量、最小量、摆动/秒、关联、时间相位、空间相位
   float maxAmount = 1.0f;  // 最大量
@@ -74,6 +82,8 @@ class RangeSelectorRenderer : public TextSelectorRenderer {
  private:
   // 计算某个字符的范围因子
   float calculateFactorByIndex(size_t index, bool* pBiasFlag) override;
+  // 批量计算所有字符的范围因子
+  void calculateFactors(float* factors) override;
   void calculateBiasFlag(bool* pBiasFlag);
 
   float rangeStart = 0.0f;
@@ -17,17 +17,35 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "VideoReader.h"
+#include <unordered_set>
 #include "base/utils/TimeUtil.h"
 #include "platform/Platform.h"
+#include "rendering/video/VideoDecoderPool.h"
 #include "tgfx/core/Clock.h"
 
 namespace pag {
 
 static constexpr int MAX_TRY_DECODE_COUNT = 100;
 static constexpr int FORCE_SOFTWARE_SIZE = 160000;  // 400x400
+static std::atomic<size_t> maxReverseCacheSize = {0};
+static std::mutex readersLocker = {};
+// 所有存活的 VideoReader，修改缓存上限时需要立即回收它们超出上限的缓存帧。
+static std::unordered_set<VideoReader*>* liveReaders = new std::unordered_set<VideoReader*>();
+
+void PAGVideoDecoder::SetMaxReverseCacheSize(size_t bytes) {
+  std::lock_guard<std::mutex> autoLock(readersLocker);
+  maxReverseCacheSize = bytes;
+  for (auto reader : *liveReaders) {
+    reader->trimReverseFrames(bytes);
+  }
+}
 
 VideoReader::VideoReader(std::unique_ptr<VideoDemuxer> videoDemuxer)
     : demuxer(videoDemuxer.release()) {
+  {
+    std::lock_guard<std::mutex> autoLock(readersLocker);
+    liveReaders->insert(this);
+  }
   auto videoFormat = demuxer->getFormat();
   frameRate = videoFormat.frameRate;
   // Force using software decoders only when external decoders are available, because the built-in
@@ -39,7 +57,11 @@ VideoReader::VideoReader(std::unique_ptr<VideoDemuxer> videoDemuxer)
 }
 
 VideoReader::~VideoReader() {
-  destroyVideoDecoder();
+  {
+    std::lock_guard<std::mutex> autoLock(readersLocker);
+    liveReaders->erase(this);
+  }
+  destroyVideoDecoder(true);
   delete demuxer;
 }
 
@@ -51,6 +73,12 @@ std::shared_ptr<tgfx::ImageBuffer> VideoReader::onMakeBuffer(Frame targetFrame)
   if (sampleTime == currentRenderedTime) {
     return lastBuffer;
   }
+  auto result = reverseFrames.find(sampleTime);
+  if (result != reverseFrames.end()) {
+    lastBuffer = result->second.buffer;
+    currentRenderedTime = sampleTime;
+    return lastBuffer;
+  }
   lastBuffer = nullptr;
   currentRenderedTime = INT64_MIN;
   if (!checkVideoDecoder()) {
@@ -126,7 +154,9 @@ bool VideoReader::sendSampleData() {
 }
 
 bool VideoReader::decodeFrame(int64_t sampleTime) {
+  bool seekingBackwards = false;
   if (demuxer->needSeeking(currentDecodedTime, sampleTime)) {
+    seekingBackwards = sampleTime < currentDecodedTime;
     resetParams();
     videoDecoder->onFlush();
     demuxer->seekTo(sampleTime);
@@ -142,6 +172,9 @@ bool VideoReader::decodeFrame(int64_t sampleTime) {
     } else if (result == DecodingResult::Success) {
       tryDecodeCount = 0;
       currentDecodedTime = videoDecoder->presentationTime();
+      if (seekingBackwards) {
+        cacheReverseFrame(sampleTime);
+      }
     } else if (result == DecodingResult::EndOfStream) {
       outputEndOfStream = true;
       return true;
@@ -155,6 +188,49 @@ bool VideoReader::decodeFrame(int64_t sampleTime) {
   return true;
 }
 
+void VideoReader::cacheReverseFrame(int64_t sampleTime) {
+  auto maxBytes = maxReverseCacheSize.load();
+  if (maxBytes == 0) {
+    clearReverseFrames();
+    return;
+  }
+  if (reverseFrames.count(currentDecodedTime) > 0) {
+    return;
+  }
+  size_t byteSize = 0;
+  auto buffer = videoDecoder->onCopyFrame(&byteSize);
+  if (buffer == nullptr) {
+    return;
+  }
+  reverseFrames[currentDecodedTime] = {std::move(buffer), byteSize};
+  reverseCacheBytes += byteSize;
+  evictReverseFrames(sampleTime, maxBytes);
+}
+
+void VideoReader::evictReverseFrames(int64_t sampleTime, size_t maxBytes) {
+  while (reverseCacheBytes > maxBytes && !reverseFrames.empty()) {
+    // 先淘汰目标帧之后已经显示过的帧，再淘汰离关键帧最近、倒放时最晚才用到的帧。
+    auto last = std::prev(reverseFrames.end());
+    auto frame = last->first > sampleTime ? last : reverseFrames.begin();
+    reverseCacheBytes -= frame->second.byteSize;
+    reverseFrames.erase(frame);
+  }
+}
+
+void VideoReader::clearReverseFrames() {
+  reverseFrames.clear();
+  reverseCacheBytes = 0;
+}
+
+void VideoReader::trimReverseFrames(size_t maxBytes) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  if (maxBytes == 0) {
+    clearReverseFrames();
+  } else {
+    evictReverseFrames(currentRenderedTime, maxBytes);
+  }
+}
+
 bool VideoReader::checkVideoDecoder() {
   if (videoDecoder) {
     return true;
@@ -166,13 +242,21 @@ bool VideoReader::checkVideoDecoder() {
   return false;
 }
 
-void VideoReader::destroyVideoDecoder() {
+void VideoReader::destroyVideoDecoder(bool reusable) {
   if (videoDecoder == nullptr) {
     return;
   }
-  delete videoDecoder;
+  if (reusable) {
+    VideoDecoderPool::Recycle(decoderFactory, demuxer->getFormat(),
+                              std::unique_ptr<VideoDecoder>(videoDecoder));
+  } else {
+    delete videoDecoder;
+  }
   videoDecoder = nullptr;
+  decoderFactory = nullptr;
   lastBuffer = nullptr;
+  // 缓存帧属于被销毁或者被替换掉的解码器，新的解码器需要重新填充。
+  clearReverseFrames();
   currentRenderedTime = INT64_MIN;
   resetParams();
 }
@@ -193,9 +277,15 @@ std::unique_ptr<VideoDecoder> VideoReader::makeVideoDecoder() {
       factoryIndex++;
       continue;
     }
+    auto decoder = VideoDecoderPool::Obtain(factory, demuxer->getFormat());
+    if (decoder != nullptr) {
+      decoderFactory = factory;
+      return decoder;
+    }
     tgfx::Clock clock = {};
-    auto decoder = factory->createDecoder(demuxer->getFormat());
+    decoder = factory->createDecoder(demuxer->getFormat());
     if (decoder != nullptr) {
+      decoderFactory = factory;
       if (decoder->isHardwareBacked()) {
         hardDecodingInitialTime = clock.elapsedTime();
       } else {
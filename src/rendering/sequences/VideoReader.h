@@ -19,6 +19,7 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 #include "SequenceReader.h"
 #include "rendering/video/VideoDecoderFactory.h"
 #include "rendering/video/VideoDemuxer.h"
@@ -50,8 +51,16 @@ class VideoReader : public SequenceReader {
   int factoryIndex = 0;
   bool preferSoftware = false;
   VideoDecoder* videoDecoder = nullptr;
+  const VideoDecoderFactory* decoderFactory = nullptr;
   VideoSample videoSample = {};
   std::shared_ptr<tgfx::ImageBuffer> lastBuffer = nullptr;
+  struct ReverseFrame {
+    std::shared_ptr<tgfx::ImageBuffer> buffer = nullptr;
+    size_t byteSize = 0;
+  };
+  // 向后 seek 时从关键帧解码到目标帧途经的帧，按显示时间排序。
+  std::map<int64_t, ReverseFrame> reverseFrames = {};
+  size_t reverseCacheBytes = 0;
   bool outputEndOfStream = false;
   bool inputEndOfStream = false;
   int64_t currentDecodedTime = INT64_MIN;
@@ -59,7 +68,7 @@ class VideoReader : public SequenceReader {
   std::atomic_int64_t hardDecodingInitialTime = 0;
   std::atomic_int64_t softDecodingInitialTime = 0;
 
-  void destroyVideoDecoder();
+  void destroyVideoDecoder(bool reusable = false);
 
   bool checkVideoDecoder();
 
@@ -69,6 +78,16 @@ class VideoReader : public SequenceReader {
 
   bool decodeFrame(int64_t sampleTime);
 
+  void cacheReverseFrame(int64_t sampleTime);
+
+  void evictReverseFrames(int64_t sampleTime, size_t maxBytes);
+
+  void clearReverseFrames();
+
+  void trimReverseFrames(size_t maxBytes);
+
   std::unique_ptr<VideoDecoder> makeVideoDecoder();
+
+  friend class PAGVideoDecoder;
 };
 }  // namespace pag
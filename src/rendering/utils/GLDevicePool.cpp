@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GLDevicePool.h"
+#include <algorithm>
+#include <chrono>
+
+namespace pag {
+static constexpr size_t MaxPooledDevices = 4;
+static constexpr size_t MaxIdleDevices = 1;
+
+std::mutex GLDevicePool::locker = {};
+std::vector<GLDevicePool::PooledDevice>* GLDevicePool::devices =
+    new std::vector<GLDevicePool::PooledDevice>();
+static thread_local tgfx::GLDevice* lastLeasedDevice = nullptr;
+
+std::shared_ptr<tgfx::GLDevice> GLDevicePool::Lease() {
+  std::shared_ptr<tgfx::GLDevice> device = nullptr;
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    PooledDevice* result = nullptr;
+    for (auto& item : *devices) {
+      if (result == nullptr || item.leases < result->leases ||
+          (item.leases == result->leases && item.device.get() == lastLeasedDevice)) {
+        result = &item;
+      }
+    }
+    if ((result == nullptr || result->leases > 0) && devices->size() < MaxPooledDevices) {
+      auto newDevice = tgfx::GLDevice::MakeWithFallback();
+      if (newDevice != nullptr) {
+        devices->push_back({std::move(newDevice), 0});
+        result = &devices->back();
+      }
+    }
+    if (result == nullptr) {
+      return nullptr;
+    }
+    result->leases++;
+    lastLeasedDevice = result->device.get();
+    device = result->device;
+  }
+  // The returned pointer shares the device but owns a separate reference count, so the pool knows
+  // exactly when the lease ends.
+  return std::shared_ptr<tgfx::GLDevice>(device.get(),
+                                         [device](tgfx::GLDevice*) { Return(device); });
+}
+
+void GLDevicePool::Return(std::shared_ptr<tgfx::GLDevice> device) {
+  {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto result = std::find_if(devices->begin(), devices->end(), [&](const PooledDevice& item) {
+      return item.device == device;
+    });
+    if (result == devices->end() || --result->leases > 0) {
+      return;
+    }
+    auto idleDevices = std::count_if(devices->begin(), devices->end(),
+                                     [](const PooledDevice& item) { return item.leases == 0; });
+    if (static_cast<size_t>(idleDevices) > MaxIdleDevices) {
+      // The device is destroyed outside the lock, once the last copy of it goes out of scope.
+      devices->erase(result);
+      return;
+    }
+  }
+  auto context = device->lockContext();
+  if (context == nullptr) {
+    return;
+  }
+  context->purgeResourcesNotUsedSince(std::chrono::steady_clock::now());
+  device->unlock();
+}
+}  // namespace pag
@@ -0,0 +1,59 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "tgfx/gpu/opengl/GLDevice.h"
+
+namespace pag {
+/**
+ * GLDevicePool shares a bounded number of offscreen GL devices across the whole process, so that
+ * creating many decoders or readers does not spin up one GL context for each of them. A device is
+ * leased for as long as the returned pointer is referenced, and it goes back to the pool once all
+ * the references are released. The devices can be used from any thread, since every access to a
+ * device is serialized by Device::lockContext().
+ */
+class GLDevicePool {
+ public:
+  /**
+   * Leases a device from the pool. The device last leased on the calling thread is preferred to
+   * keep its context current, unless another device is serving fewer leases. New devices are
+   * created lazily until the pool reaches its capacity. Returns nullptr if no device is available.
+   */
+  static std::shared_ptr<tgfx::GLDevice> Lease();
+
+ private:
+  struct PooledDevice {
+    std::shared_ptr<tgfx::GLDevice> device = nullptr;
+    int leases = 0;
+  };
+
+  static std::mutex locker;
+  static std::vector<PooledDevice>* devices;
+
+  /**
+   * Called when the last reference of a lease is released. Once a device serves no lease, the
+   * resources cached in its context are purged, and it is destroyed if another device is already
+   * idle.
+   */
+  static void Return(std::shared_ptr<tgfx::GLDevice> device);
+};
+}  // namespace pag
@@ -17,8 +17,10 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "MemoryCalculator.h"
+#include <mutex>
 #include "base/utils/Log.h"
 #include "rendering/caches/LayerCache.h"
+#include "tgfx/core/Task.h"
 
 namespace pag {
 static void* GetCacheResourcesForLayer(Layer* layer) {
@@ -310,10 +312,7 @@ void MemoryCalculator::CaculateResourcesMaxScaleAndTimeRanges(
                              resourcesTimeRangesMap);
 }
 
-int64_t CalculateGraphicsMemory(std::shared_ptr<File> file) {
-  if (file == nullptr) {
-    return 0;
-  }
+static std::vector<int64_t> CalculateMemoriesPerFrame(std::shared_ptr<File> file) {
   auto rootLayer = file->getRootLayer();
   std::unordered_map<void*, tgfx::Point> resourcesMaxScaleMap;
   std::unordered_map<void*, std::vector<TimeRange>*> resourcesTimeRangesMap;
@@ -321,14 +320,128 @@ int64_t CalculateGraphicsMemory(std::shared_ptr<File> file) {
                                                            resourcesTimeRangesMap);
   std::vector<int64_t> memoriesPreFrame = MemoryCalculator::GetRootLayerGraphicsMemoriesPreFrame(
       rootLayer, resourcesMaxScaleMap, resourcesTimeRangesMap);
-  int64_t maxGraphicsMemory = 0;
-  for (std::vector<int64_t>::size_type i = 0; i < memoriesPreFrame.size(); i++) {
-    maxGraphicsMemory =
-        maxGraphicsMemory > memoriesPreFrame[i] ? maxGraphicsMemory : memoriesPreFrame[i];
-  }
   for (auto it = resourcesTimeRangesMap.begin(); it != resourcesTimeRangesMap.end(); it++) {
     delete it->second;
   }
+  return memoriesPreFrame;
+}
+
+struct MemoryProfile {
+  std::weak_ptr<File> file;
+  // nullptr if the profile is still being calculated in background.
+  std::shared_ptr<const std::vector<int64_t>> memories = nullptr;
+};
+
+// 计算过程需要遍历所有图层内容，RenderCache 每帧都会查询，这里按 File 对象缓存计算结果。锁只保护缓存
+// 表本身，计算过程总是在锁外进行，避免阻塞其他播放器。
+static constexpr size_t MinPurgeableProfiles = 16;
+static std::mutex profileLocker = {};
+static std::unordered_map<const File*, MemoryProfile> memoryProfiles = {};
+static size_t purgeableProfiles = MinPurgeableProfiles;
+
+static void RemoveExpiredProfiles() {
+  // 缓存数量翻倍时才清理一次已释放的文件，均摊到每次插入的开销是常数级的。
+  if (memoryProfiles.size() < purgeableProfiles) {
+    return;
+  }
+  for (auto item = memoryProfiles.begin(); item != memoryProfiles.end();) {
+    if (item->second.file.expired()) {
+      item = memoryProfiles.erase(item);
+    } else {
+      item++;
+    }
+  }
+  purgeableProfiles = std::max(MinPurgeableProfiles, memoryProfiles.size() * 2);
+}
+
+static MemoryProfile* FindProfile(const std::shared_ptr<File>& file) {
+  auto result = memoryProfiles.find(file.get());
+  if (result == memoryProfiles.end()) {
+    return nullptr;
+  }
+  if (result->second.file.lock() != file) {
+    // 地址被新的 File 复用了。
+    memoryProfiles.erase(result);
+    return nullptr;
+  }
+  return &result->second;
+}
+
+static std::shared_ptr<const std::vector<int64_t>> StoreProfile(
+    const std::shared_ptr<File>& file, std::shared_ptr<const std::vector<int64_t>> memories) {
+  std::lock_guard<std::mutex> autoLock(profileLocker);
+  auto profile = FindProfile(file);
+  if (profile == nullptr) {
+    RemoveExpiredProfiles();
+    profile = &memoryProfiles[file.get()];
+    profile->file = file;
+  }
+  if (profile->memories == nullptr) {
+    profile->memories = std::move(memories);
+  }
+  return profile->memories;
+}
+
+static std::shared_ptr<const std::vector<int64_t>> MakeProfile(std::shared_ptr<File> file) {
+  return std::make_shared<const std::vector<int64_t>>(CalculateMemoriesPerFrame(file));
+}
+
+std::shared_ptr<const std::vector<int64_t>> MemoryCalculator::GetGraphicsMemoriesPerFrame(
+    std::shared_ptr<File> file) {
+  if (file == nullptr) {
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> autoLock(profileLocker);
+    auto profile = FindProfile(file);
+    if (profile != nullptr && profile->memories != nullptr) {
+      return profile->memories;
+    }
+  }
+  return StoreProfile(file, MakeProfile(file));
+}
+
+std::shared_ptr<const std::vector<int64_t>> MemoryCalculator::RequestGraphicsMemoriesPerFrame(
+    std::shared_ptr<File> file) {
+  if (file == nullptr) {
+    return nullptr;
+  }
+  {
+    std::lock_guard<std::mutex> autoLock(profileLocker);
+    auto profile = FindProfile(file);
+    if (profile != nullptr) {
+      return profile->memories;
+    }
+    RemoveExpiredProfiles();
+    memoryProfiles[file.get()].file = file;
+  }
+  std::weak_ptr<File> weakFile = file;
+  tgfx::Task::Run([weakFile]() {
+    auto file = weakFile.lock();
+    if (file != nullptr) {
+      StoreProfile(file, MakeProfile(file));
+    }
+  });
+  return nullptr;
+}
+
+int64_t CalculateGraphicsMemory(std::shared_ptr<File> file) {
+  auto memoriesPreFrame = MemoryCalculator::GetGraphicsMemoriesPerFrame(file);
+  if (memoriesPreFrame == nullptr) {
+    return 0;
+  }
+  int64_t maxGraphicsMemory = 0;
+  for (auto memory : *memoriesPreFrame) {
+    maxGraphicsMemory = std::max(maxGraphicsMemory, memory);
+  }
   return maxGraphicsMemory;
 }
+
+std::vector<int64_t> CalculateGraphicsMemoriesPerFrame(std::shared_ptr<File> file) {
+  auto memoriesPreFrame = MemoryCalculator::GetGraphicsMemoriesPerFrame(file);
+  if (memoriesPreFrame == nullptr) {
+    return {};
+  }
+  return *memoriesPreFrame;
+}
 }  // namespace pag
@@ -34,6 +34,20 @@ class MemoryCalculator {
       PreComposeLayer* rootLayer, std::unordered_map<void*, tgfx::Point>& resourcesScaleMap,
       std::unordered_map<void*, std::vector<TimeRange>*>& resourcesTimeRangesMap);
 
+  /**
+   * Returns the estimated graphics memory of each frame of the file at its original size. The
+   * result is calculated only once for each file and shared until the file is released.
+   */
+  static std::shared_ptr<const std::vector<int64_t>> GetGraphicsMemoriesPerFrame(
+      std::shared_ptr<File> file);
+
+  /**
+   * Returns the same result as GetGraphicsMemoriesPerFrame() if it is available, otherwise starts
+   * calculating it in background and returns nullptr immediately.
+   */
+  static std::shared_ptr<const std::vector<int64_t>> RequestGraphicsMemoriesPerFrame(
+      std::shared_ptr<File> file);
+
  private:
   static void FillBitmapGraphicsMemories(
       Composition* composition, std::unordered_map<void*, tgfx::Point>& resourcesScaleMap,
@@ -0,0 +1,79 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "VirtualDisplayLink.h"
+
+namespace pag {
+std::shared_ptr<VirtualDisplayLink> VirtualDisplayLink::Make(std::function<void()> callback,
+                                                             int64_t frameInterval,
+                                                             int64_t startTime) {
+  if (callback == nullptr || frameInterval <= 0) {
+    return nullptr;
+  }
+  return std::shared_ptr<VirtualDisplayLink>(
+      new VirtualDisplayLink(std::move(callback), frameInterval, startTime));
+}
+
+VirtualDisplayLink::VirtualDisplayLink(std::function<void()> callback, int64_t frameInterval,
+                                       int64_t startTime)
+    : callback(std::move(callback)), _frameInterval(frameInterval), currentTime(startTime) {
+}
+
+void VirtualDisplayLink::start() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  running = true;
+}
+
+void VirtualDisplayLink::stop() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  running = false;
+}
+
+bool VirtualDisplayLink::isRunning() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return running;
+}
+
+int64_t VirtualDisplayLink::now() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return currentTime;
+}
+
+int64_t VirtualDisplayLink::frameInterval() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return _frameInterval;
+}
+
+void VirtualDisplayLink::advance(int64_t time) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  currentTime += time;
+}
+
+void VirtualDisplayLink::tick(int frames) {
+  for (int i = 0; i < frames; i++) {
+    locker.lock();
+    currentTime += _frameInterval;
+    auto needCallback = running;
+    locker.unlock();
+    // 回调里可能会停止 DisplayLink，不能持有锁调用。
+    if (needCallback) {
+      callback();
+    }
+  }
+}
+}  // namespace pag
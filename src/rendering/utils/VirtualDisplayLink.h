@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "rendering/utils/DisplayLink.h"
+
+namespace pag {
+/**
+ * VirtualDisplayLink is a display link driven by a virtual clock instead of the screen refresh. It
+ * only fires when tick() is called, which allows animations to be scheduled and tested without a
+ * real display.
+ */
+class VirtualDisplayLink : public DisplayLink {
+ public:
+  /**
+   * Creates a VirtualDisplayLink that advances the virtual clock by frameInterval microseconds on
+   * every tick. The virtual clock starts from the specified time.
+   */
+  static std::shared_ptr<VirtualDisplayLink> Make(std::function<void()> callback,
+                                                  int64_t frameInterval, int64_t startTime);
+
+  void start() override;
+
+  void stop() override;
+
+  /**
+   * Returns true if the display link is started.
+   */
+  bool isRunning();
+
+  /**
+   * Returns the current time of the virtual clock in microseconds.
+   */
+  int64_t now();
+
+  /**
+   * Returns the time the virtual clock advances on every tick, in microseconds.
+   */
+  int64_t frameInterval();
+
+  /**
+   * Advances the virtual clock by the given time without firing the callback. Calling it from an
+   * animation callback simulates a frame that takes the given time to render.
+   */
+  void advance(int64_t time);
+
+  /**
+   * Advances the virtual clock by the given number of frames. The callback is invoked once for
+   * every frame while the display link is running.
+   */
+  void tick(int frames = 1);
+
+ private:
+  std::mutex locker = {};
+  std::function<void()> callback = nullptr;
+  int64_t _frameInterval = 0;
+  int64_t currentTime = 0;
+  bool running = false;
+
+  VirtualDisplayLink(std::function<void()> callback, int64_t frameInterval, int64_t startTime);
+};
+}  // namespace pag
@@ -21,9 +21,11 @@
 #include "TextShaperHarfbuzz.h"
 #include <list>
 #include <map>
+#include <unordered_set>
 #include "base/utils/Log.h"
 #include "hb.h"
 #include "rendering/FontManager.h"
+#include "tgfx/core/UTF.h"
 
 namespace pag {
 template <typename T>
@@ -232,6 +234,29 @@ static bool Shape(std::list<HBGlyph>& glyphs, std::shared_ptr<tgfx::Typeface> ty
   return allShaped;
 }
 
+// 收集未整形字符各自命中的 fallback 字体，这些字体按 fallback 列表的顺序优先尝试。
+static std::unordered_set<tgfx::Typeface*> GetFallbackHints(const std::list<HBGlyph>& glyphs) {
+  std::unordered_set<tgfx::Typeface*> hints;
+  for (const auto& glyph : glyphs) {
+    if (glyph.glyphID != 0) {
+      continue;
+    }
+    const char* textStart = glyph.text.data();
+    const char* textStop = textStart + glyph.text.size();
+    while (textStart < textStop) {
+      auto oldPosition = textStart;
+      tgfx::UTF::NextUTF8(&textStart, textStop);
+      tgfx::GlyphID glyphID = 0;
+      auto typeface = FontManager::GetFallbackTypeface(
+          std::string(oldPosition, textStart - oldPosition), &glyphID);
+      if (typeface != nullptr) {
+        hints.insert(typeface.get());
+      }
+    }
+  }
+  return hints;
+}
+
 PositionedGlyphs TextShaperHarfbuzz::Shape(const std::string& text,
                                            std::shared_ptr<tgfx::Typeface> face) {
   std::list<HBGlyph> glyphs;
@@ -242,12 +267,22 @@ PositionedGlyphs TextShaperHarfbuzz::Shape(const std::string& text,
   }
   if (!allShaped) {
     auto typefaces = FontManager::GetFallbackTypefaces();
+    auto hints = GetFallbackHints(glyphs);
     for (const auto& faceHolder : typefaces) {
       auto typeface = faceHolder->getTypeface();
-      if (typeface && ::pag::Shape(glyphs, std::move(typeface))) {
+      if (typeface && hints.count(typeface.get()) > 0 &&
+          ::pag::Shape(glyphs, std::move(typeface))) {
+        allShaped = true;
         break;
       }
     }
+    // 逐字符的命中结果覆盖不了需要组合整形的字符时，再依次尝试其余的 fallback 字体。
+    for (size_t i = 0; !allShaped && i < typefaces.size(); i++) {
+      auto typeface = typefaces[i]->getTypeface();
+      if (typeface && hints.count(typeface.get()) == 0) {
+        allShaped = ::pag::Shape(glyphs, std::move(typeface));
+      }
+    }
   }
   std::vector<std::tuple<std::shared_ptr<tgfx::Typeface>, tgfx::GlyphID, uint32_t>> glyphIDs;
   for (const auto& glyph : glyphs) {
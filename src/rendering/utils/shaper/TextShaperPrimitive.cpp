@@ -26,7 +26,6 @@ PositionedGlyphs TextShaperPrimitive::Shape(const std::string& text,
   const char* textStart = text.data();
   const char* textStop = textStart + text.size();
   std::vector<std::tuple<std::shared_ptr<tgfx::Typeface>, tgfx::GlyphID, uint32_t>> glyphs;
-  auto fallbackTypefaces = FontManager::GetFallbackTypefaces();
   while (textStart < textStop) {
     auto oldPosition = textStart;
     tgfx::UTF::NextUTF8(&textStart, textStop);
@@ -34,16 +33,9 @@ PositionedGlyphs TextShaperPrimitive::Shape(const std::string& text,
     auto str = std::string(oldPosition, length);
     auto glyphID = typeface ? typeface->getGlyphID(str) : 0;
     if (glyphID == 0) {
-      for (const auto& faceHolder : fallbackTypefaces) {
-        auto face = faceHolder->getTypeface();
-        if (face == nullptr) {
-          continue;
-        }
-        glyphID = face->getGlyphID(str);
-        if (glyphID != 0) {
-          glyphs.emplace_back(std::move(face), glyphID, oldPosition - text.data());
-          break;
-        }
+      auto face = FontManager::GetFallbackTypeface(str, &glyphID);
+      if (face != nullptr) {
+        glyphs.emplace_back(std::move(face), glyphID, oldPosition - text.data());
       }
     } else {
       glyphs.emplace_back(typeface, glyphID, oldPosition - text.data());
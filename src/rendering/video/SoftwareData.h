@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <cstring>
 #include <vector>
 #include "tgfx/core/YUVData.h"
 
@@ -33,6 +34,31 @@ class SoftwareData : public tgfx::YUVData {
     return std::shared_ptr<YUVData>(data);
   }
 
+  /**
+   * Copies the I420 planes into memory owned by the returned data, so that it stays valid after the
+   * decoder outputs more frames. The copied size, including the row padding, is written into
+   * byteSize.
+   */
+  static std::shared_ptr<YUVData> MakeCopy(int width, int height, uint8_t* buffer[3],
+                                           const int lineSize[3], int planeCount,
+                                           size_t* byteSize) {
+    auto data = new SoftwareData(width, height, buffer, lineSize, planeCount, nullptr);
+    size_t totalSize = 0;
+    for (int i = 0; i < planeCount; i++) {
+      totalSize += data->rowBytes[i] * PlaneHeight(height, i);
+    }
+    data->pixels.resize(totalSize);
+    *byteSize = totalSize;
+    size_t offset = 0;
+    for (int i = 0; i < planeCount; i++) {
+      auto planeSize = data->rowBytes[i] * PlaneHeight(height, i);
+      memcpy(data->pixels.data() + offset, buffer[i], planeSize);
+      data->data[i] = data->pixels.data() + offset;
+      offset += planeSize;
+    }
+    return std::shared_ptr<YUVData>(data);
+  }
+
  private:
   int width() const override {
     return _width;
@@ -61,6 +87,12 @@ class SoftwareData : public tgfx::YUVData {
   std::vector<size_t> rowBytes = {};
   // hold a reference to the software decoder to keep the yuv data alive.
   std::shared_ptr<T> softwareDecoder = nullptr;
+  // the copied yuv planes, only used by the data created from MakeCopy().
+  std::vector<uint8_t> pixels = {};
+
+  static size_t PlaneHeight(int height, int planeIndex) {
+    return static_cast<size_t>(planeIndex == 0 ? height : (height + 1) / 2);
+  }
 
   SoftwareData(int width, int height, uint8_t* buffer[3], const int lineSize[3], int planeCount,
                std::shared_ptr<T> softwareDecoder)
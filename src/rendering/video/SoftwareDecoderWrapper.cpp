@@ -154,6 +154,17 @@ std::shared_ptr<tgfx::ImageBuffer> SoftwareDecoderWrapper::onRenderFrame() {
   return tgfx::ImageBuffer::MakeI420(std::move(yuvData), videoFormat.colorSpace);
 }
 
+std::shared_ptr<tgfx::ImageBuffer> SoftwareDecoderWrapper::onCopyFrame(size_t* byteSize) {
+  auto frame = softwareDecoder->onRenderFrame();
+  if (frame == nullptr) {
+    return nullptr;
+  }
+  auto yuvData = SoftwareData<SoftwareDecoder>::MakeCopy(videoFormat.width, videoFormat.height,
+                                                         frame->data, frame->lineSize,
+                                                         I420_PLANE_COUNT, byteSize);
+  return tgfx::ImageBuffer::MakeI420(std::move(yuvData), videoFormat.colorSpace);
+}
+
 int64_t SoftwareDecoderWrapper::presentationTime() {
   return currentDecodedTime;
 }
@@ -61,6 +61,15 @@ class VideoDecoder {
    */
   virtual std::shared_ptr<tgfx::ImageBuffer> onRenderFrame() = 0;
 
+  /**
+   * Returns a copy of the decoded video frame, which stays valid after more frames are decoded, and
+   * writes the number of bytes the copy occupies into byteSize. Returns nullptr if the decoder does
+   * not support copying its frames.
+   */
+  virtual std::shared_ptr<tgfx::ImageBuffer> onCopyFrame(size_t*) {
+    return nullptr;
+  }
+
   /**
    * Returns current presentation time.
    */
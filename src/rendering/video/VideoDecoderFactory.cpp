@@ -20,6 +20,7 @@
 #include <atomic>
 #include "SoftAVCDecoder.h"
 #include "SoftwareDecoderWrapper.h"
+#include "VideoDecoderPool.h"
 #include "base/utils/USE.h"
 #include "pag/pag.h"
 
@@ -34,8 +35,13 @@ static std::atomic_int maxHardwareDecoderCount = {65535};
 static std::atomic_int globalHardwareDecoderCount = {0};
 
 void PAGVideoDecoder::RegisterSoftwareDecoderFactory(SoftwareDecoderFactory* decoderFactory) {
-  std::lock_guard<std::mutex> autoLock(factoryLocker);
-  softwareDecoderFactory = decoderFactory;
+  {
+    std::lock_guard<std::mutex> autoLock(factoryLocker);
+    softwareDecoderFactory = decoderFactory;
+  }
+  // The idle decoders were created by the previous factory, which may be released by the caller
+  // once it is unregistered.
+  VideoDecoderPool::Clear(VideoDecoderFactory::ExternalDecoderFactory());
 }
 
 void PAGVideoDecoder::SetMaxHardwareDecoderCount(int count) {
@@ -115,8 +121,11 @@ void VideoDecoderFactory::NotifyHardwareVideoDecoderReleased() {
 
 std::unique_ptr<VideoDecoder> VideoDecoderFactory::createDecoder(const VideoFormat& format) const {
   auto hardwareBacked = isHardwareBacked();
-  if (hardwareBacked && globalHardwareDecoderCount >= maxHardwareDecoderCount) {
-    return nullptr;
+  // Idle hardware decoders in the pool also count, release one of them to make room if possible.
+  while (hardwareBacked && globalHardwareDecoderCount >= maxHardwareDecoderCount) {
+    if (!VideoDecoderPool::ReleaseHardwareDecoder()) {
+      return nullptr;
+    }
   }
   auto decoder = onCreateDecoder(format);
   if (decoder != nullptr) {
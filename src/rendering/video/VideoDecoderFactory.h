@@ -61,6 +61,14 @@ class VideoDecoderFactory {
    */
   virtual bool isHardwareBacked() const = 0;
 
+  /**
+   * Returns true if the decoders created by this factory only depend on the video format, and can
+   * be handed over to another video reader with the same format after flushing.
+   */
+  virtual bool canReuseDecoders() const {
+    return true;
+  }
+
  protected:
   virtual std::unique_ptr<VideoDecoder> onCreateDecoder(const VideoFormat& format) const = 0;
 
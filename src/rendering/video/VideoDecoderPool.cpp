@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "VideoDecoderPool.h"
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include "pag/pag.h"
+
+namespace pag {
+struct IdleDecoder {
+  const VideoDecoderFactory* factory = nullptr;
+  std::string formatKey;
+  std::unique_ptr<VideoDecoder> decoder = nullptr;
+};
+
+static std::mutex poolLocker = {};
+static std::atomic_int maxIdleDecoderCount = {4};
+// Intentionally leaked, the platform decoders must not be torn down during static destruction.
+static auto idleDecoders = new std::list<IdleDecoder>();
+
+void PAGVideoDecoder::SetMaxIdleDecoderCount(int count) {
+  maxIdleDecoderCount = std::max(count, 0);
+  std::list<IdleDecoder> expiredDecoders = {};
+  {
+    std::lock_guard<std::mutex> autoLock(poolLocker);
+    while (static_cast<int>(idleDecoders->size()) > maxIdleDecoderCount) {
+      expiredDecoders.splice(expiredDecoders.end(), *idleDecoders, idleDecoders->begin());
+    }
+  }
+}
+
+// The headers are copied into the key, since their bytes are usually owned by the pag file.
+static std::string MakeFormatKey(const VideoFormat& format) {
+  std::string key = format.mimeType + "|" + std::to_string(format.width) + "x" +
+                    std::to_string(format.height) + "|" +
+                    std::to_string(static_cast<int>(format.colorSpace)) + "|" +
+                    std::to_string(format.maxReorderSize);
+  for (auto& header : format.headers) {
+    key += "|" + std::to_string(header->size()) + ":";
+    key.append(static_cast<const char*>(header->data()), header->size());
+  }
+  return key;
+}
+
+std::unique_ptr<VideoDecoder> VideoDecoderPool::Obtain(const VideoDecoderFactory* factory,
+                                                       const VideoFormat& format) {
+  if (maxIdleDecoderCount == 0 || !factory->canReuseDecoders()) {
+    return nullptr;
+  }
+  auto formatKey = MakeFormatKey(format);
+  std::unique_ptr<VideoDecoder> decoder = nullptr;
+  {
+    std::lock_guard<std::mutex> autoLock(poolLocker);
+    for (auto item = idleDecoders->rbegin(); item != idleDecoders->rend(); item++) {
+      if (item->factory == factory && item->formatKey == formatKey) {
+        decoder = std::move(item->decoder);
+        idleDecoders->erase(std::next(item).base());
+        break;
+      }
+    }
+  }
+  if (decoder != nullptr) {
+    decoder->onFlush();
+  }
+  return decoder;
+}
+
+void VideoDecoderPool::Recycle(const VideoDecoderFactory* factory, const VideoFormat& format,
+                               std::unique_ptr<VideoDecoder> decoder) {
+  if (decoder == nullptr || maxIdleDecoderCount == 0 || !factory->canReuseDecoders()) {
+    return;
+  }
+  std::list<IdleDecoder> expiredDecoders = {};
+  {
+    std::lock_guard<std::mutex> autoLock(poolLocker);
+    idleDecoders->push_back({factory, MakeFormatKey(format), std::move(decoder)});
+    while (static_cast<int>(idleDecoders->size()) > maxIdleDecoderCount) {
+      expiredDecoders.splice(expiredDecoders.end(), *idleDecoders, idleDecoders->begin());
+    }
+  }
+  // The expired decoders are destroyed out of the lock.
+}
+
+bool VideoDecoderPool::ReleaseHardwareDecoder() {
+  std::unique_ptr<VideoDecoder> decoder = nullptr;
+  {
+    std::lock_guard<std::mutex> autoLock(poolLocker);
+    for (auto item = idleDecoders->begin(); item != idleDecoders->end(); item++) {
+      if (item->decoder->isHardwareBacked()) {
+        decoder = std::move(item->decoder);
+        idleDecoders->erase(item);
+        break;
+      }
+    }
+  }
+  return decoder != nullptr;
+}
+
+void VideoDecoderPool::Clear(const VideoDecoderFactory* factory) {
+  std::list<IdleDecoder> expiredDecoders = {};
+  {
+    std::lock_guard<std::mutex> autoLock(poolLocker);
+    for (auto item = idleDecoders->begin(); item != idleDecoders->end();) {
+      auto current = item++;
+      if (current->factory == factory) {
+        expiredDecoders.splice(expiredDecoders.end(), *idleDecoders, current);
+      }
+    }
+  }
+  // The expired decoders are destroyed out of the lock.
+}
+}  // namespace pag
@@ -0,0 +1,58 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "rendering/video/VideoDecoderFactory.h"
+
+namespace pag {
+/**
+ * VideoDecoderPool keeps the video decoders released by video readers, so that a new reader with
+ * the same video format can take one over instead of paying the initialization time of a new
+ * decoder again. The idle decoders are keyed by their factory, codec, resolution and codec headers,
+ * and the least recently released ones are destroyed once the pool exceeds its capacity.
+ */
+class VideoDecoderPool {
+ public:
+  /**
+   * Takes an idle decoder created by the factory for the same video format out of the pool, and
+   * flushes it before returning. Returns nullptr if there is no such decoder.
+   */
+  static std::unique_ptr<VideoDecoder> Obtain(const VideoDecoderFactory* factory,
+                                              const VideoFormat& format);
+
+  /**
+   * Returns a decoder that is no longer used to the pool. The decoder is destroyed directly if the
+   * factory does not allow reusing its decoders or the pool is disabled.
+   */
+  static void Recycle(const VideoDecoderFactory* factory, const VideoFormat& format,
+                      std::unique_ptr<VideoDecoder> decoder);
+
+  /**
+   * Destroys the least recently released hardware decoder in the pool to make room for a new one.
+   * Returns false if there is no idle hardware decoder.
+   */
+  static bool ReleaseHardwareDecoder();
+
+  /**
+   * Destroys all idle decoders created by the factory, e.g. when the factory starts creating
+   * decoders from a different implementation.
+   */
+  static void Clear(const VideoDecoderFactory* factory);
+};
+}  // namespace pag
@@ -0,0 +1,125 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "rendering/AnimationTicker.h"
+#include "utils/TestUtils.h"
+
+namespace pag {
+class CountingListener : public PAGAnimator::Listener {
+ public:
+  int updateCount = 0;
+  int endCount = 0;
+  // 每次刷新时推进虚拟时钟的时长，用来模拟耗时的渲染。
+  int64_t frameCost = 0;
+  std::shared_ptr<VirtualDisplayLink> displayLink = nullptr;
+
+ protected:
+  void onAnimationEnd(PAGAnimator*) override {
+    endCount++;
+  }
+
+  void onAnimationUpdate(PAGAnimator*) override {
+    updateCount++;
+    if (frameCost > 0 && displayLink != nullptr) {
+      displayLink->advance(frameCost);
+    }
+  }
+};
+
+/**
+ * 用例描述: 使用虚拟时钟驱动 PAGAnimator，测试不可见和低优先级动画的调度
+ */
+PAG_TEST(PAGAnimatorTest, VirtualDisplayLink) {
+  auto ticker = AnimationTicker::GetInstance();
+  auto displayLink = ticker->useVirtualDisplayLink(10000);
+  ASSERT_TRUE(displayLink != nullptr);
+  auto listener = std::make_shared<CountingListener>();
+  auto animator = PAGAnimator::MakeFrom(listener);
+  ASSERT_TRUE(animator != nullptr);
+  animator->setSync(true);
+  animator->setDuration(100000);
+  animator->start();
+  EXPECT_TRUE(displayLink->isRunning());
+  EXPECT_EQ(listener->updateCount, 1);
+  displayLink->tick(5);
+  EXPECT_EQ(listener->updateCount, 6);
+  EXPECT_NEAR(animator->progress(), 0.5, 0.001);
+
+  animator->setVisible(false);
+  displayLink->tick(2);
+  EXPECT_EQ(listener->updateCount, 6);
+  EXPECT_NEAR(animator->progress(), 0.7, 0.001);
+  animator->setVisible(true);
+  EXPECT_EQ(listener->updateCount, 7);
+
+  displayLink->tick(3);
+  EXPECT_FALSE(animator->isRunning());
+  EXPECT_FALSE(displayLink->isRunning());
+  EXPECT_EQ(listener->endCount, 1);
+  EXPECT_EQ(animator->progress(), 1.0);
+  auto statistics = animator->statistics();
+  EXPECT_EQ(statistics.renderedFrames, 10);
+  EXPECT_EQ(statistics.skippedFrames, 2);
+  EXPECT_EQ(statistics.droppedFrames, 0);
+
+  auto lowListener = std::make_shared<CountingListener>();
+  lowListener->displayLink = displayLink;
+  auto lowAnimator = PAGAnimator::MakeFrom(lowListener);
+  ASSERT_TRUE(lowAnimator != nullptr);
+  lowAnimator->setSync(true);
+  lowAnimator->setPriority(PAGAnimator::Priority::Low);
+  lowAnimator->setDuration(1000000);
+  lowAnimator->start();
+  displayLink->tick(10);
+  EXPECT_EQ(ticker->loadLevel(), 0);
+  EXPECT_EQ(lowListener->updateCount, 11);
+  // 一帧的渲染耗时超过了帧间隔，负载升高一级。
+  lowListener->frameCost = 15000;
+  displayLink->tick();
+  lowListener->frameCost = 0;
+  EXPECT_EQ(ticker->loadLevel(), 1);
+  EXPECT_EQ(lowListener->updateCount, 12);
+  // 负载升高后，低优先级的动画每 2^loadLevel 帧才刷新一次。
+  displayLink->tick(10);
+  EXPECT_EQ(ticker->loadLevel(), 1);
+  EXPECT_EQ(lowListener->updateCount, 17);
+  EXPECT_EQ(lowAnimator->statistics().skippedFrames, 5);
+  EXPECT_NEAR(lowAnimator->progress(), 0.225, 0.001);
+
+  // 多个低优先级的动画错开刷新，每一帧只有其中一个在渲染。
+  auto otherListener = std::make_shared<CountingListener>();
+  auto otherAnimator = PAGAnimator::MakeFrom(otherListener);
+  ASSERT_TRUE(otherAnimator != nullptr);
+  otherAnimator->setSync(true);
+  otherAnimator->setPriority(PAGAnimator::Priority::Low);
+  otherAnimator->setDuration(1000000);
+  otherAnimator->start();
+  EXPECT_EQ(otherListener->updateCount, 1);
+  for (int i = 0; i < 4; i++) {
+    auto updateCount = lowListener->updateCount + otherListener->updateCount;
+    displayLink->tick();
+    EXPECT_EQ(lowListener->updateCount + otherListener->updateCount, updateCount + 1);
+  }
+  EXPECT_EQ(lowListener->updateCount, 19);
+  EXPECT_EQ(otherListener->updateCount, 3);
+  otherAnimator->cancel();
+  lowAnimator->cancel();
+  EXPECT_FALSE(displayLink->isRunning());
+  ticker->useVirtualDisplayLink(0);
+}
+}  // namespace pag
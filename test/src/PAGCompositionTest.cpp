@@ -17,6 +17,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "nlohmann/json.hpp"
+#include "rendering/caches/RenderCache.h"
+#include "rendering/graphics/Recorder.h"
+#include "rendering/layers/PAGStage.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -102,6 +105,46 @@ PAG_TEST(PAGCompositionTest, VideoSequence) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGCompositionTest/VideoSequence"));
 }
 
+/**
+ * 用例描述: 子图层的录制结果在滤镜质量变化、图层被修改或隐藏后会失效并重新录制
+ */
+PAG_TEST(PAGCompositionTest, RetainedGraphic) {
+  PAG_SETUP(TestPAGSurface, TestPAGPlayer, TestPAGFile);
+  auto pagComposition = std::static_pointer_cast<PAGComposition>(TestPAGFile->getLayerAt(0));
+  TestPAGPlayer->flush();
+  auto stage = TestPAGPlayer->stage.get();
+  Recorder recorder = {};
+  std::shared_ptr<PAGLayer> childLayer = nullptr;
+  std::shared_ptr<Graphic> graphic = nullptr;
+  for (int i = 0; i < pagComposition->numChildren() && graphic == nullptr; i++) {
+    childLayer = pagComposition->getLayerAt(i);
+    PAGComposition::DrawChildLayer(&recorder, childLayer.get());
+    graphic = stage->getRetainedGraphic(childLayer.get());
+  }
+  ASSERT_TRUE(graphic != nullptr);
+  PAGComposition::DrawChildLayer(&recorder, childLayer.get());
+  EXPECT_EQ(stage->getRetainedGraphic(childLayer.get()), graphic);
+
+  auto renderCache = TestPAGPlayer->renderCache;
+  renderCache->setAdaptiveQuality(true);
+  renderCache->updateFilterQuality(1000000, 16666);
+  EXPECT_TRUE(stage->getRetainedGraphic(childLayer.get()) == nullptr);
+  PAGComposition::DrawChildLayer(&recorder, childLayer.get());
+  auto lowQualityGraphic = stage->getRetainedGraphic(childLayer.get());
+  ASSERT_TRUE(lowQualityGraphic != nullptr);
+  EXPECT_NE(lowQualityGraphic, graphic);
+
+  childLayer->notifyModified(true);
+  EXPECT_TRUE(stage->getRetainedGraphic(childLayer.get()) == nullptr);
+  PAGComposition::DrawChildLayer(&recorder, childLayer.get());
+  EXPECT_TRUE(stage->getRetainedGraphic(childLayer.get()) != nullptr);
+
+  childLayer->layerVisible = false;
+  pagComposition->draw(&recorder);
+  EXPECT_TRUE(stage->getRetainedGraphic(childLayer.get()) == nullptr);
+  childLayer->layerVisible = true;
+}
+
 /**
  * 用例描述: PAGCompositionLayer getLayerAt
  */
@@ -528,6 +571,98 @@ PAG_TEST(ContainerTest, HitTestPoint) {
   // TODO VideoSequenceContent
 }
 
+/**
+ * 用例描述: ContainerTest HitBounds，子图层的命中包围盒包含所有能命中的点，并在图层修改后重新计算
+ */
+PAG_TEST(ContainerTest, HitBounds) {
+  PAG_SETUP(TestPAGSurface, TestPAGPlayer, TestPAGFile);
+  auto testComposition = std::static_pointer_cast<PAGComposition>(TestPAGFile->getLayerAt(0));
+  testComposition->setCurrentTime(0.8 * 1000000);
+  TestPAGPlayer->flush();
+  auto stage = TestPAGPlayer->stage;
+  for (auto& childLayer : testComposition->layers) {
+    tgfx::Rect hitBounds = {};
+    PAGComposition::MeasureChildHitBounds(&hitBounds, childLayer.get());
+    tgfx::Rect cachedBounds = {};
+    EXPECT_TRUE(stage->getHitBounds(childLayer.get(), &cachedBounds));
+    for (int y = 0; y < testComposition->height(); y += 40) {
+      for (int x = 0; x < testComposition->width(); x += 40) {
+        std::vector<std::shared_ptr<PAGLayer>> results = {};
+        auto pointX = static_cast<float>(x);
+        auto pointY = static_cast<float>(y);
+        if (PAGComposition::GetChildLayerAtPoint(childLayer.get(), pointX, pointY, &results)) {
+          EXPECT_TRUE(hitBounds.contains(pointX, pointY));
+        }
+      }
+    }
+  }
+
+  int target = 0;
+  auto solidLayer = GetLayer(testComposition, LayerType::Solid, target);
+  ASSERT_NE(solidLayer, nullptr);
+  auto parentLayer = solidLayer->_parent;
+  ASSERT_NE(parentLayer, nullptr);
+  tgfx::Rect hitBounds = {};
+  PAGComposition::MeasureChildHitBounds(&hitBounds, solidLayer.get());
+  ASSERT_FALSE(hitBounds.isEmpty());
+  tgfx::Rect parentBounds = {};
+  PAGComposition::MeasureChildHitBounds(&parentBounds, parentLayer);
+  auto matrix = solidLayer->getMatrix();
+  matrix.postTranslate(100, 50);
+  solidLayer->setMatrix(matrix);
+  // 图层及其父图层的包围盒都需要重新计算。
+  tgfx::Rect cachedBounds = {};
+  EXPECT_FALSE(stage->getHitBounds(solidLayer.get(), &cachedBounds));
+  EXPECT_FALSE(stage->getHitBounds(parentLayer, &cachedBounds));
+  tgfx::Rect movedBounds = {};
+  PAGComposition::MeasureChildHitBounds(&movedBounds, solidLayer.get());
+  EXPECT_FLOAT_EQ(movedBounds.left, hitBounds.left + 100);
+  EXPECT_FLOAT_EQ(movedBounds.top, hitBounds.top + 50);
+  EXPECT_FLOAT_EQ(movedBounds.width(), hitBounds.width());
+  EXPECT_FLOAT_EQ(movedBounds.height(), hitBounds.height());
+  solidLayer->resetMatrix();
+}
+
+/**
+ * 用例描述: ContainerTest HitTestPath，不透明的矢量内容直接用路径在 CPU 上测试，图片内容才需要回读像素
+ */
+PAG_TEST(ContainerTest, HitTestPath) {
+  PAG_SETUP(TestPAGSurface, TestPAGPlayer, TestPAGFile);
+  auto testComposition = std::static_pointer_cast<PAGComposition>(TestPAGFile->getLayerAt(0));
+  testComposition->setCurrentTime(0.8 * 1000000);
+  TestPAGPlayer->flush();
+  int target = 0;
+  auto solidLayer = GetLayer(testComposition, LayerType::Solid, target);
+  ASSERT_NE(solidLayer, nullptr);
+  Recorder recorder = {};
+  solidLayer->draw(&recorder);
+  auto graphic = recorder.makeGraphic();
+  ASSERT_NE(graphic, nullptr);
+  tgfx::Path path = {};
+  ASSERT_TRUE(graphic->getPath(&path));
+  auto pathBounds = path.getBounds();
+  EXPECT_TRUE(path.contains(pathBounds.centerX(), pathBounds.centerY()));
+  // 路径包含右下边界，与像素测试的结果一致。
+  EXPECT_TRUE(TestPAGPlayer->hitTestPoint(solidLayer, 720, 1080, true));
+  // 图层没有变化时，再次测试复用已录制的内容。
+  auto hitTestGraphic = TestPAGPlayer->stage->getHitTestGraphic(solidLayer.get());
+  ASSERT_NE(hitTestGraphic, nullptr);
+  EXPECT_FALSE(TestPAGPlayer->hitTestPoint(solidLayer, 721, 1081, true));
+  EXPECT_EQ(TestPAGPlayer->stage->getHitTestGraphic(solidLayer.get()), hitTestGraphic);
+
+  testComposition->setCurrentTime(3 * 1000000);
+  TestPAGPlayer->flush();
+  target = 0;
+  auto imageLayer = GetLayer(testComposition, LayerType::Image, target);
+  ASSERT_NE(imageLayer, nullptr);
+  Recorder imageRecorder = {};
+  imageLayer->draw(&imageRecorder);
+  auto imageGraphic = imageRecorder.makeGraphic();
+  ASSERT_NE(imageGraphic, nullptr);
+  EXPECT_FALSE(imageGraphic->getPath(&path));
+  EXPECT_TRUE(TestPAGPlayer->hitTestPoint(imageLayer, 366, 174, true));
+}
+
 /**
  * 用例描述: 视频序列帧HitTest
  */
@@ -629,4 +764,66 @@ PAG_TEST(ContainerTest, GetLayersUnderPointImage) {
   results = testComposition->getLayersUnderPoint(360, 500);
   EXPECT_EQ(static_cast<int>(results.size()), 1);
 }
+
+/**
+ * 用例描述: 跨越子图层的可见范围跳转时，只访问可见的子图层，被跳过的子图层的时间仍然正确
+ */
+PAG_TEST(PAGCompositionTest, LayerTimeline) {
+  auto root = PAGComposition::Make(100, 100);
+  auto layerA = PAGSolidLayer::Make(1000000, 100, 100, Red);
+  auto layerB = PAGSolidLayer::Make(1000000, 100, 100, Green);
+  layerB->setStartTime(2000000);
+  auto nested = PAGComposition::Make(100, 100);
+  auto layerD = PAGSolidLayer::Make(1000000, 100, 100, Blue);
+  nested->addLayer(layerD);
+  nested->setStartTime(4000000);
+  root->addLayer(layerA);
+  root->addLayer(layerB);
+  root->addLayer(nested);
+
+  auto checkTimes = [&](int64_t time) {
+    EXPECT_EQ(root->currentTime(), time);
+    EXPECT_EQ(layerA->currentTime(), time);
+    EXPECT_EQ(layerB->currentTime(), time);
+    EXPECT_EQ(nested->currentTime(), time);
+    EXPECT_EQ(layerD->currentTime(), time - 4000000);
+  };
+  auto getVisitedLayers = [&]() {
+    auto& layers = root->timeline->layersToVisit;
+    return std::vector<PAGLayer*>(layers.begin(), layers.end());
+  };
+
+  // 第一次跳转重建索引，访问所有子图层。
+  root->setCurrentTime(500000);
+  EXPECT_EQ(getVisitedLayers().size(), 3u);
+  EXPECT_TRUE(layerA->frameVisible());
+  EXPECT_FALSE(layerB->frameVisible());
+  checkTimes(500000);
+
+  // 向后跳转到 B 的可见范围，只访问上一次可见的 A 和新进入可见范围的 B。
+  root->setCurrentTime(2500000);
+  EXPECT_EQ(getVisitedLayers(), (std::vector<PAGLayer*>{layerA.get(), layerB.get()}));
+  EXPECT_FALSE(layerA->frameVisible());
+  EXPECT_TRUE(layerB->frameVisible());
+  checkTimes(2500000);
+
+  // 跳转到嵌套的合成内，A 前后都不可见，被整体跳过。
+  root->setCurrentTime(4500000);
+  EXPECT_EQ(getVisitedLayers(), (std::vector<PAGLayer*>{layerB.get(), nested.get()}));
+  EXPECT_FALSE(layerB->frameVisible());
+  EXPECT_TRUE(nested->frameVisible());
+  EXPECT_TRUE(layerD->frameVisible());
+  checkTimes(4500000);
+
+  // 向前跳回 A 的可见范围，只访问上一次可见的合成和重新进入可见范围的 A。
+  root->setCurrentTime(200000);
+  EXPECT_EQ(getVisitedLayers(), (std::vector<PAGLayer*>{nested.get(), layerA.get()}));
+  EXPECT_TRUE(layerA->frameVisible());
+  EXPECT_FALSE(nested->frameVisible());
+  checkTimes(200000);
+
+  // 直接设置的子图层时间在父级再次跳转之前保持不变。
+  layerB->setCurrentTime(2500000);
+  EXPECT_EQ(layerB->currentTime(), 2500000);
+}
 }  // namespace pag
@@ -0,0 +1,105 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making libpag available.
+//
+//  Copyright (C) 2023 THL A29 Limited, a Tencent company. All rights reserved.
+//
+//  Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+//  except in compliance with the License. You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "pag/pag.h"
+#include "rendering/caches/FrameProvider.h"
+#include "utils/TestUtils.h"
+
+namespace pag {
+/**
+ * 用例描述: FrameProvider 复用像素缓冲区，并以 LZ4 压缩的形式在内存中缓存所有帧
+ */
+PAG_TEST(PAGDecoderTest, FrameProvider) {
+  pag::PAGDiskCache::RemoveAll();
+  auto pagFile = LoadPAGFile("resources/apitest/ImageDecodeTest.pag");
+  ASSERT_TRUE(pagFile != nullptr);
+  auto provider = FrameProvider::Make(PAGDecoder::MakeFrom(pagFile, 24.0f));
+  ASSERT_TRUE(provider != nullptr);
+  pagFile = nullptr;
+  provider->setCacheAllFramesInMemory(true);
+  auto frame = provider->readFrame(0);
+  ASSERT_TRUE(frame != nullptr);
+  tgfx::Pixmap pixmap(frame->info(), frame->pixels());
+  EXPECT_TRUE(Baseline::Compare(pixmap, "PAGDiskCacheTest/decoder_Image_0"));
+  auto cacheSize = provider->memoryCacheSize();
+  EXPECT_GT(cacheSize, 0u);
+  EXPECT_LT(cacheSize, frame->info().byteSize());
+  auto pixels = frame->pixels();
+  frame = nullptr;
+  // 同一静止区间内的帧直接复用空闲缓冲区和内存缓存。
+  frame = provider->readFrame(7);
+  ASSERT_TRUE(frame != nullptr);
+  EXPECT_EQ(frame->pixels(), pixels);
+  EXPECT_EQ(frame->frameIndex(), 7);
+  EXPECT_EQ(provider->memoryCacheSize(), cacheSize);
+  auto nextFrame = provider->readFrame(11);
+  ASSERT_TRUE(nextFrame != nullptr);
+  EXPECT_NE(nextFrame->pixels(), pixels);
+  pixmap.reset(nextFrame->info(), nextFrame->pixels());
+  EXPECT_TRUE(Baseline::Compare(pixmap, "PAGDiskCacheTest/decoder_Image_11"));
+  EXPECT_GT(provider->memoryCacheSize(), cacheSize);
+  frame = nullptr;
+  nextFrame = nullptr;
+  pag::PAGDiskCache::RemoveAll();
+  frame = provider->readFrame(0);
+  ASSERT_TRUE(frame != nullptr);
+  pixmap.reset(frame->info(), frame->pixels());
+  EXPECT_TRUE(Baseline::Compare(pixmap, "PAGDiskCacheTest/decoder_Image_0"));
+  provider->setCacheAllFramesInMemory(false);
+  EXPECT_EQ(provider->memoryCacheSize(), 0u);
+  frame = nullptr;
+  provider = nullptr;
+  pag::PAGDiskCache::RemoveAll();
+}
+
+static void ExpectSameTimeRanges(const std::vector<TimeRange>& a, const std::vector<TimeRange>& b) {
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    EXPECT_EQ(a[i].start, b[i].start);
+    EXPECT_EQ(a[i].end, b[i].end);
+  }
+}
+
+/**
+ * 用例描述: 未修改的 PAGFile 直接由文件的静态区间换算出解码器的静态区间，结果与逐帧跳转的结果一致
+ */
+PAG_TEST(PAGDecoderTest, StaticTimeRanges) {
+  std::vector<std::string> paths = {"resources/apitest/test.pag",
+                                    "resources/apitest/ImageDecodeTest.pag"};
+  for (auto& path : paths) {
+    auto pagFile = LoadPAGFile(path);
+    ASSERT_TRUE(pagFile != nullptr);
+    for (auto maxFrameRate : {24.0f, 60.0f}) {
+      auto numFrames = PAGDecoder::GetFrameCountAndRate(pagFile, maxFrameRate).first;
+      ExpectSameTimeRanges(PAGDecoder::GetFileStaticTimeRange(pagFile.get(), numFrames),
+                           PAGDecoder::ScanStaticTimeRange(pagFile.get(), numFrames));
+    }
+  }
+
+  // 有图层不跟随时间轴时，文件的静态区间不再适用，需要逐帧跳转计算。
+  auto pagFile = LoadPAGFile("resources/apitest/test.pag");
+  ASSERT_TRUE(pagFile != nullptr);
+  EXPECT_FALSE(PAGDecoder::HasExcludedLayers(pagFile.get()));
+  auto pagComposition = std::static_pointer_cast<PAGComposition>(pagFile->getLayerAt(0));
+  pagComposition->getLayerAt(0)->setExcludedFromTimeline(true);
+  EXPECT_TRUE(PAGDecoder::HasExcludedLayers(pagFile.get()));
+  auto numFrames = PAGDecoder::GetFrameCountAndRate(pagFile, 24.0f).first;
+  ExpectSameTimeRanges(PAGDecoder::GetStaticTimeRange(pagFile, numFrames),
+                       PAGDecoder::ScanStaticTimeRange(pagFile.get(), numFrames));
+}
+}  // namespace pag
@@ -18,8 +18,11 @@
 
 #include <filesystem>
 #include "pag/pag.h"
+#include "base/utils/HashUtil.h"
+#include "base/utils/StaticTimeRangesScope.h"
 #include "platform/Platform.h"
 #include "rendering/caches/DiskCache.h"
+#include "rendering/caches/FileSnapshot.h"
 #include "rendering/utils/BitmapBuffer.h"
 #include "rendering/utils/Directory.h"
 #include "utils/TestUtils.h"
@@ -429,4 +432,51 @@ PAG_TEST(PAGDiskCacheTest, FileCache) {
   pag::PAGDiskCache::RemoveAll();
 }
 
+/**
+ * 用例描述: 从 FileSnapshot 恢复的静态区间与重新解码计算的结果一致，与文件不匹配或校验和不一致的快照会被忽略
+ */
+PAG_TEST(PAGDiskCacheTest, FileSnapshot) {
+  pag::PAGDiskCache::RemoveAll();
+  auto data = ReadFile("resources/apitest/ZC2.pag");
+  ASSERT_TRUE(data != nullptr);
+  auto freshFile = Codec::Decode(data->data(), static_cast<uint32_t>(data->size()), "");
+  ASSERT_TRUE(freshFile != nullptr);
+  auto key = FileSnapshot::MakeKey(Hash64(data->data(), data->size()), data->size());
+  auto checksum = Checksum64(data->data(), data->size());
+  FileSnapshot::WriteStaticTimeRanges(key, checksum, freshFile->compositions);
+  EXPECT_TRUE(FileSnapshot::ReadStaticTimeRanges(key, checksum + 1).empty());
+  auto timeRanges = FileSnapshot::ReadStaticTimeRanges(key, checksum);
+  ASSERT_EQ(timeRanges.size(), freshFile->compositions.size());
+
+  std::shared_ptr<File> restoredFile = nullptr;
+  {
+    StaticTimeRangesScope scope([&]() { return timeRanges; });
+    EXPECT_FALSE(scope.decoded());
+    restoredFile = Codec::Decode(data->data(), static_cast<uint32_t>(data->size()), "");
+    EXPECT_TRUE(scope.decoded());
+    EXPECT_TRUE(scope.restored());
+  }
+  ASSERT_TRUE(restoredFile != nullptr);
+  ASSERT_EQ(restoredFile->compositions.size(), freshFile->compositions.size());
+  for (size_t i = 0; i < freshFile->compositions.size(); i++) {
+    auto& freshRanges = freshFile->compositions[i]->staticTimeRanges;
+    auto& restoredRanges = restoredFile->compositions[i]->staticTimeRanges;
+    ASSERT_EQ(restoredRanges.size(), freshRanges.size());
+    for (size_t j = 0; j < freshRanges.size(); j++) {
+      EXPECT_EQ(restoredRanges[j].start, freshRanges[j].start);
+      EXPECT_EQ(restoredRanges[j].end, freshRanges[j].end);
+    }
+  }
+
+  timeRanges.pop_back();
+  {
+    StaticTimeRangesScope scope([&]() { return timeRanges; });
+    auto file = Codec::Decode(data->data(), static_cast<uint32_t>(data->size()), "");
+    ASSERT_TRUE(file != nullptr);
+    EXPECT_TRUE(scope.decoded());
+    EXPECT_FALSE(scope.restored());
+  }
+  pag::PAGDiskCache::RemoveAll();
+}
+
 }  // namespace pag
@@ -16,7 +16,14 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "base/keyframes/KeyframeArena.h"
+#include "base/keyframes/SingleEaseKeyframe.h"
 #include "base/utils/TimeUtil.h"
+#include "codec/AttributeHelper.h"
+#include "codec/CodecContext.h"
+#include "codec/TagHeader.h"
+#include "codec/tags/layerStyles/DropShadowStyle.h"
+#include "codec/tags/shapes/Dashes.h"
 #include "nlohmann/json.hpp"
 #include "utils/TestUtils.h"
 
@@ -333,6 +340,11 @@ PAG_TEST(PAGFileLoadTest, loadTest) {
   file = PAGFile::Load(byteData->data(), byteData->length());
   ASSERT_TRUE(file != nullptr);
 
+  // identical bytes share one decoded file
+  auto sameFile = PAGFile::Load(byteData->data(), byteData->length());
+  ASSERT_TRUE(sameFile != nullptr);
+  EXPECT_EQ(sameFile->getFile(), file->getFile());
+
   // error length
   file = PAGFile::Load(byteData->data(), byteData->length() - 20);
   ASSERT_TRUE(file == nullptr);
@@ -718,4 +730,245 @@ PAG_TEST(PAGFileTest, EditableIndices) {
   ASSERT_EQ(editableTexts[1], static_cast<int>(0));
 }
 
+/**
+ * 用例描述: 逐帧显存预测
+ */
+PAG_TEST(PAGFileTest, GraphicsMemoriesPerFrame) {
+  auto file = File::Load("resources/apitest/test.pag");
+  ASSERT_NE(file, nullptr);
+  auto memories = CalculateGraphicsMemoriesPerFrame(file);
+  ASSERT_EQ(static_cast<Frame>(memories.size()), file->getRootLayer()->composition->duration);
+  int64_t maxMemory = 0;
+  for (auto memory : memories) {
+    EXPECT_GE(memory, 0);
+    maxMemory = std::max(maxMemory, memory);
+  }
+  EXPECT_GT(maxMemory, 0);
+  EXPECT_EQ(CalculateGraphicsMemory(file), maxMemory);
+  EXPECT_EQ(CalculateGraphicsMemoriesPerFrame(nullptr).size(), 0lu);
+}
+
+// 以下是原地写入之前的编码方式：标签内容先写入临时的流，再连同 header 一起拷贝到父节点的流里。
+static void WriteTagByCopy(EncodeStream* stream, EncodeStream* tagBytes, TagCode code) {
+  auto length = tagBytes->length();
+  uint16_t typeAndLength = static_cast<uint16_t>(code) << 6;
+  if (length < 63) {
+    stream->writeUint16(typeAndLength | static_cast<uint8_t>(length));
+  } else {
+    stream->writeUint16(typeAndLength | static_cast<uint8_t>(63));
+    stream->writeUint32(length);
+  }
+  stream->writeBytes(tagBytes);
+}
+
+static void WriteTagBlockByCopy(EncodeStream* stream, BlockConfig* tagConfig) {
+  EncodeStream flagBytes(stream->context);
+  EncodeStream bytes(stream->context);
+  int index = 0;
+  for (auto& config : tagConfig->configs) {
+    config->writeAttribute(&flagBytes, &bytes, tagConfig->targets[index++]);
+  }
+  flagBytes.alignWithBytes();
+  flagBytes.writeBytes(&bytes);
+  WriteTagByCopy(stream, &flagBytes, tagConfig->tagCode);
+}
+
+static void WriteBlockByCopy(EncodeStream* stream, BlockConfig* tagConfig) {
+  stream->alignWithBytes();
+  EncodeStream contentBytes(stream->context);
+  int index = 0;
+  for (auto& config : tagConfig->configs) {
+    config->writeAttribute(stream, &contentBytes, tagConfig->targets[index++]);
+  }
+  stream->alignWithBytes();
+  stream->writeBytes(&contentBytes);
+}
+
+static const AttributeConfig<float> DashOffsetConfig = {AttributeType::SimpleProperty, 0.0f};
+static const AttributeConfig<float> DashConfig = {AttributeType::SimpleProperty, 10.0f};
+
+static void WriteDashesByCopy(EncodeStream* stream, std::vector<Property<float>*>& dashes,
+                              Property<float>* dashOffset) {
+  stream->alignWithBytes();
+  EncodeStream contentBytes(stream->context);
+  auto dashLength = std::min(static_cast<uint32_t>(dashes.size()), 6u);
+  stream->writeUBits(dashLength - 1, 3);
+  DashOffsetConfig.writeAttribute(stream, &contentBytes, &dashOffset);
+  for (uint32_t i = 0; i < dashLength; i++) {
+    DashConfig.writeAttribute(stream, &contentBytes, &(dashes[i]));
+  }
+  stream->writeBytes(&contentBytes);
+}
+
+static TagCode WriteInnerTag(EncodeStream* stream, uint32_t length) {
+  for (uint32_t i = 0; i < length; i++) {
+    stream->writeUint8(static_cast<uint8_t>(i));
+  }
+  // 结尾留下不满一个字节的内容，检查 header 回填前的字节对齐。
+  stream->writeUBits(5, 3);
+  return TagCode::FileAttributes;
+}
+
+static TagCode WriteOuterTag(EncodeStream* stream, uint32_t length) {
+  stream->writeBitBoolean(true);
+  WriteTag(stream, length, WriteInnerTag);
+  WriteTag(stream, length * 2, WriteInnerTag);
+  return TagCode::DropShadowStyle;
+}
+
+static TagCode WriteOuterTagByCopy(EncodeStream* stream, uint32_t length) {
+  stream->writeBitBoolean(true);
+  for (auto innerLength : {length, length * 2}) {
+    EncodeStream bytes(stream->context);
+    auto code = WriteInnerTag(&bytes, innerLength);
+    WriteTagByCopy(stream, &bytes, code);
+  }
+  return TagCode::DropShadowStyle;
+}
+
+static Property<float>* MakeAnimatableFloat(float startValue, float endValue) {
+  auto keyframe = new Keyframe<float>();
+  keyframe->startValue = startValue;
+  keyframe->endValue = endValue;
+  keyframe->startTime = 0;
+  keyframe->endTime = 10;
+  keyframe->interpolationType = KeyframeInterpolationType::Linear;
+  return new AnimatableProperty<float>({keyframe});
+}
+
+static void ExpectSameBytes(EncodeStream* stream, EncodeStream* expected) {
+  auto data = stream->release();
+  auto expectedData = expected->release();
+  ASSERT_EQ(data->length(), expectedData->length());
+  EXPECT_EQ(memcmp(data->data(), expectedData->data(), data->length()), 0);
+}
+
+/**
+ * 用例描述: 原地写入标签的编码结果与先写临时流再拷贝的结果逐字节一致
+ */
+PAG_TEST(PAGFileTest, EncodeTagsInPlace) {
+  CodecContext context = {};
+  // 覆盖短格式和长格式 header 的边界：内部标签的内容长度为 length + 1 字节。
+  for (uint32_t length : {0u, 1u, 20u, 30u, 31u, 61u, 62u, 63u, 200u}) {
+    EncodeStream stream(&context);
+    stream.writeUBits(3, 2);
+    WriteTag(&stream, length, WriteOuterTag);
+    EncodeStream expected(&context);
+    expected.writeUBits(3, 2);
+    EncodeStream bytes(&context);
+    auto code = WriteOuterTagByCopy(&bytes, length);
+    WriteTagByCopy(&expected, &bytes, code);
+    ExpectSameBytes(&stream, &expected);
+  }
+
+  DropShadowStyle style = {};
+  style.blendMode = new Property<Enum>(static_cast<Enum>(BlendMode::Multiply));
+  style.color = new Property<Color>(Black);
+  style.opacity = new Property<Opacity>(128);
+  style.angle = MakeAnimatableFloat(30.0f, 90.0f);
+  style.size = new Property<float>(12.0f);
+  {
+    EncodeStream stream(&context);
+    WriteTagBlock(&stream, &style, DropShadowStyleTag);
+    EncodeStream expected(&context);
+    WriteTagBlockByCopy(&expected, DropShadowStyleTag(&style).get());
+    ExpectSameBytes(&stream, &expected);
+  }
+  {
+    EncodeStream stream(&context);
+    stream.writeBitBoolean(true);
+    WriteBlock(&stream, &style, DropShadowStyleTag);
+    stream.writeUBits(6, 3);
+    EncodeStream expected(&context);
+    expected.writeBitBoolean(true);
+    WriteBlockByCopy(&expected, DropShadowStyleTag(&style).get());
+    expected.writeUBits(6, 3);
+    ExpectSameBytes(&stream, &expected);
+  }
+
+  std::vector<Property<float>*> dashes = {
+      new Property<float>(10.0f), new Property<float>(4.0f), MakeAnimatableFloat(2.0f, 8.0f),
+      new Property<float>(10.0f), new Property<float>(6.0f), new Property<float>(3.0f),
+      new Property<float>(5.0f)};
+  auto dashOffset = MakeAnimatableFloat(0.0f, 20.0f);
+  {
+    EncodeStream stream(&context);
+    stream.writeBitBoolean(true);
+    WriteDashes(&stream, dashes, dashOffset);
+    EncodeStream expected(&context);
+    expected.writeBitBoolean(true);
+    WriteDashesByCopy(&expected, dashes, dashOffset);
+    ExpectSameBytes(&stream, &expected);
+  }
+  for (auto& dash : dashes) {
+    delete dash;
+  }
+  delete dashOffset;
+
+  // header 没能完整写入时不能在流里留下全零的 End 标签。
+  EncodeStream stream(&context);
+  stream.writeUint8(1);
+  auto headerPosition = BeginTagHeader(&stream);
+  stream.removeBytes(headerPosition + 2, 4);
+  EndTagHeader(&stream, headerPosition, TagCode::FileAttributes);
+  EXPECT_EQ(stream.length(), 1u);
+
+  // 编码后的文件重新解码再编码，结果逐字节一致。
+  for (auto& path : {"resources/apitest/complex_test.pag", "resources/apitest/ShapeType.pag",
+                     "resources/apitest/test_font.pag"}) {
+    auto file = LoadPAGFile(path);
+    ASSERT_NE(file, nullptr) << path;
+    auto encodeData = Codec::Encode(file->getFile());
+    ASSERT_NE(encodeData, nullptr);
+    auto verifyFile =
+        Codec::Decode(encodeData->data(), static_cast<uint32_t>(encodeData->length()), "");
+    ASSERT_NE(verifyFile, nullptr);
+    auto verifyData = Codec::Encode(verifyFile);
+    ASSERT_EQ(verifyData->length(), encodeData->length());
+    EXPECT_EQ(memcmp(verifyData->data(), encodeData->data(), encodeData->length()), 0) << path;
+  }
+}
+
+/**
+ * 用例描述: 解码作用域内创建的 ArenaKeyframe 从 KeyframeArena 分配，arena 在作用域和所有关键帧释放后才释放，
+ * 普通的 Keyframe 不受 arena 影响
+ */
+PAG_TEST(PAGFileTest, KeyframeArenaLifetime) {
+  std::vector<Keyframe<float>*> keyframes = {};
+  KeyframeArena* arena = nullptr;
+  {
+    KeyframeArenaScope arenaScope;
+    arena = arenaScope.arena;
+    for (int i = 0; i < 1000; i++) {
+      auto keyframe = new ArenaKeyframe<SingleEaseKeyframe<float>>();
+      keyframe->startValue = static_cast<float>(i);
+      keyframes.push_back(keyframe);
+    }
+    EXPECT_EQ(arena->refCount, 1001);
+    {
+      // 嵌套的作用域使用新的 arena，结束后恢复外层的 arena。
+      KeyframeArenaScope innerScope;
+      delete new ArenaKeyframe<Keyframe<float>>();
+      EXPECT_EQ(innerScope.arena->refCount, 1);
+    }
+    keyframes.push_back(new ArenaKeyframe<Keyframe<float>>());
+    EXPECT_EQ(arena->refCount, 1002);
+    // 普通的 Keyframe 始终从堆上分配。
+    delete new Keyframe<float>();
+    EXPECT_EQ(arena->refCount, 1002);
+  }
+  // 作用域结束后 arena 由关键帧持有，作用域外创建的关键帧从堆上分配。
+  EXPECT_EQ(arena->refCount, 1001);
+  delete new ArenaKeyframe<Keyframe<float>>();
+  EXPECT_EQ(arena->refCount, 1001);
+  for (size_t i = 1; i < keyframes.size(); i++) {
+    delete keyframes[i];
+  }
+  EXPECT_EQ(arena->refCount, 1);
+  // 最后一个关键帧的内存仍然有效。
+  EXPECT_EQ(keyframes[0]->startValue, 0.0f);
+  keyframes[0]->startValue = 1.0f;
+  EXPECT_EQ(keyframes[0]->startValue, 1.0f);
+  delete keyframes[0];
+}
 }  // namespace pag
@@ -17,7 +17,12 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <fstream>
+#include "base/utils/TimeUtil.h"
 #include "nlohmann/json.hpp"
+#include "rendering/caches/LayerCache.h"
+#include "rendering/caches/RenderCache.h"
+#include "rendering/filters/LayerFilter.h"
+#include "rendering/filters/Transform3DFilter.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -124,6 +129,30 @@ PAG_TEST(PAGFilterTest, GaussBlur) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/GaussBlur_FastBlur_NoRepeat"));
 }
 
+/**
+ * 用例描述: 预热滤镜后的渲染结果与懒加载一致
+ */
+PAG_TEST(PAGFilterTest, WarmUp) {
+  auto pagFile = LoadPAGFile("resources/filter/fastblur.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setComposition(pagFile);
+  EXPECT_EQ(pagPlayer->warmUp(), -1);
+  auto pagSurface = OffscreenSurface::Make(pagFile->width(), pagFile->height());
+  ASSERT_NE(pagSurface, nullptr);
+  pagPlayer->setSurface(pagSurface);
+  auto count = pagPlayer->warmUp();
+  EXPECT_GT(count, 0);
+  auto filterCount = pagPlayer->renderCache->filterCaches.size();
+  EXPECT_EQ(pagPlayer->warmUp(), count);
+  EXPECT_EQ(pagPlayer->renderCache->filterCaches.size(), filterCount);
+
+  pagFile->setCurrentTime(1000000);
+  pagPlayer->flush();
+  EXPECT_EQ(pagPlayer->renderCache->filterCaches.size(), filterCount);
+  EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/GaussBlur_FastBlur"));
+}
+
 /**
  * 用例描述: Glow效果测试
  */
@@ -355,6 +384,75 @@ PAG_TEST(PAGFilterTest, FeatherMask) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/FeatherMask"));
 }
 
+/**
+ * 用例描述: 同一个 Context 内相同类型的滤镜共用一个 program
+ */
+PAG_TEST(PAGFilterTest, SharedFilterProgram) {
+  auto device = GLDevicePool::Lease();
+  ASSERT_TRUE(device != nullptr);
+  auto context = device->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  MosaicEffect firstEffect = {};
+  MosaicEffect secondEffect = {};
+  BrightnessContrastEffect otherEffect = {};
+  auto firstFilter = LayerFilter::Make(&firstEffect);
+  auto secondFilter = LayerFilter::Make(&secondEffect);
+  auto otherFilter = LayerFilter::Make(&otherEffect);
+  ASSERT_TRUE(firstFilter != nullptr && secondFilter != nullptr && otherFilter != nullptr);
+  EXPECT_TRUE(firstFilter->initialize(context));
+  EXPECT_TRUE(secondFilter->initialize(context));
+  EXPECT_TRUE(otherFilter->initialize(context));
+  ASSERT_TRUE(firstFilter->filterProgram != nullptr);
+  EXPECT_EQ(firstFilter->filterProgram, secondFilter->filterProgram);
+  EXPECT_NE(firstFilter->filterProgram, otherFilter->filterProgram);
+  firstFilter = nullptr;
+  secondFilter = nullptr;
+  otherFilter = nullptr;
+  device->unlock();
+}
+
+/**
+ * 用例描述: 羽化遮罩的快照在同一个静态区间内的多帧之间复用
+ */
+PAG_TEST(PAGFilterTest, FeatherMaskSnapshot) {
+  auto pagFile = LoadPAGFile("resources/filter/FeatherMask.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagSurface = OffscreenSurface::Make(pagFile->width(), pagFile->height());
+  ASSERT_NE(pagSurface, nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  FeatherMaskCache* featherMaskCache = nullptr;
+  Layer* maskLayer = nullptr;
+  for (auto layer : static_cast<VectorComposition*>(pagFile->getFile()->getRootLayer()->composition)
+                        ->layers) {
+    featherMaskCache = LayerCache::Get(layer)->featherMaskCache;
+    if (featherMaskCache != nullptr) {
+      maskLayer = layer;
+      break;
+    }
+  }
+  ASSERT_NE(featherMaskCache, nullptr);
+  auto featherMaskID = featherMaskCache->uniqueID();
+  EXPECT_NE(pagPlayer->renderCache->stage->getLayerFromReferenceMap(featherMaskID), nullptr);
+  auto staticRange = std::find_if(featherMaskCache->staticTimeRanges.begin(),
+                                  featherMaskCache->staticTimeRanges.end(),
+                                  [](const TimeRange& range) { return range.end > range.start; });
+  ASSERT_NE(staticRange, featherMaskCache->staticTimeRanges.end());
+  auto frameRate = pagFile->frameRate();
+  auto startFrame = maskLayer->startTime + staticRange->start;
+  pagFile->setCurrentTime(FrameToTime(startFrame, frameRate));
+  pagPlayer->flush();
+  auto& snapshotCaches = pagPlayer->renderCache->snapshotCaches;
+  ASSERT_EQ(snapshotCaches.count(featherMaskID), 1u);
+  // 持有快照的纹理，避免重新生成的快照复用同一块内存导致误判。
+  auto image = snapshotCaches[featherMaskID]->image;
+  pagFile->setCurrentTime(FrameToTime(startFrame + 1, frameRate));
+  pagPlayer->flush();
+  ASSERT_EQ(snapshotCaches.count(featherMaskID), 1u);
+  EXPECT_EQ(snapshotCaches[featherMaskID]->image, image);
+}
+
 /**
  * 用例描述: Corner Pin 缩放
  */
@@ -467,4 +565,207 @@ PAG_TEST(PAGFilterTest, DefaultFeatherMask) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/DefaultFeatherMask"));
 }
 
+static Transform3D* MakeTransform3D(const Point3D& anchorPoint, const Point3D& position) {
+  auto transform = new Transform3D();
+  transform->anchorPoint = new Property<Point3D>(anchorPoint);
+  transform->position = new Property<Point3D>(position);
+  transform->scale = new Property<Point3D>(Point3D::Make(1, 1, 1));
+  transform->orientation = new Property<Point3D>(Point3D::Make(0, 0, 0));
+  transform->xRotation = new Property<float>(0);
+  transform->yRotation = new Property<float>(0);
+  transform->zRotation = new Property<float>(0);
+  transform->opacity = new Property<Opacity>(Opaque);
+  return transform;
+}
+
+static Transform2D* MakeTransform2D(const Point& position, const Point& scale) {
+  auto transform = new Transform2D();
+  transform->anchorPoint = new Property<Point>(Point::Zero());
+  transform->position = new Property<Point>(position);
+  transform->scale = new Property<Point>(scale);
+  transform->rotation = new Property<float>(0);
+  transform->opacity = new Property<Opacity>(Opaque);
+  return transform;
+}
+
+// 双节点摄像机，锚点即目标点。
+static CameraLayer* MakeCameraLayer(VectorComposition* composition, const Point3D& position,
+                                    const Point3D& target, float zoom) {
+  auto camera = new CameraLayer();
+  camera->containingComposition = composition;
+  camera->duration = composition->duration;
+  camera->transform3D = MakeTransform3D(target, position);
+  auto option = new CameraOption();
+  option->zoom = new Property<float>(zoom);
+  option->depthOfField = new Property<bool>(false);
+  option->focusDistance = new Property<float>(zoom);
+  option->aperture = new Property<float>(0);
+  option->blurLevel = new Property<Percent>(1.0f);
+  option->irisShape = new Property<Enum>(0);
+  option->irisRotation = new Property<float>(0);
+  option->irisRoundness = new Property<Percent>(0);
+  option->irisAspectRatio = new Property<float>(1);
+  option->irisDiffractionFringe = new Property<float>(0);
+  option->highlightGain = new Property<float>(0);
+  option->highlightThreshold = new Property<float>(1);
+  option->highlightSaturation = new Property<float>(0);
+  camera->cameraOption = option;
+  return camera;
+}
+
+/**
+ * 用例描述: 3D 图层在默认摄像机下的投影范围
+ */
+PAG_TEST(PAGFilterTest, Transform3DBounds) {
+  auto composition = std::make_unique<VectorComposition>();
+  composition->width = 200;
+  composition->height = 100;
+  auto layer = new SolidLayer();
+  layer->containingComposition = composition.get();
+  composition->layers.push_back(layer);
+  auto transform = MakeTransform3D(Point3D::Make(50, 25, 0), Point3D::Make(100, 50, 0));
+  layer->transform3D = transform;
+
+  // z = 0 的平面与默认摄像机的焦平面重合，投影后保持原大小。
+  auto bounds = tgfx::Rect::MakeWH(100, 50);
+  EXPECT_TRUE(Transform3DFilter::TransformBounds(&bounds, layer, 0));
+  EXPECT_EQ(bounds, tgfx::Rect::MakeLTRB(50, 25, 150, 75));
+
+  // 距离摄像机两倍焦距时，投影缩小一半并向画面中心收拢。
+  auto zoom = 200.0f * 50.0f / 36.0f;
+  transform->position->value = Point3D::Make(100, 50, zoom);
+  bounds = tgfx::Rect::MakeWH(100, 50);
+  EXPECT_TRUE(Transform3DFilter::TransformBounds(&bounds, layer, 0));
+  EXPECT_FLOAT_EQ(bounds.left, 75);
+  EXPECT_FLOAT_EQ(bounds.top, 37.5f);
+  EXPECT_FLOAT_EQ(bounds.right, 125);
+  EXPECT_FLOAT_EQ(bounds.bottom, 62.5f);
+
+  // 位于摄像机后方的图层不可见。
+  transform->position->value = Point3D::Make(100, 50, -zoom * 2);
+  bounds = tgfx::Rect::MakeWH(100, 50);
+  EXPECT_FALSE(Transform3DFilter::TransformBounds(&bounds, layer, 0));
+  EXPECT_TRUE(bounds.isEmpty());
+
+  // 与默认摄像机位置相同的摄像机图层得到相同的投影结果。
+  composition->duration = 1;
+  layer->duration = 1;
+  transform->position->value = Point3D::Make(100, 50, 0);
+  auto camera = MakeCameraLayer(composition.get(), Point3D::Make(100, 50, -zoom),
+                                Point3D::Make(100, 50, 0), zoom);
+  composition->layers.push_back(camera);
+  bounds = tgfx::Rect::MakeWH(100, 50);
+  EXPECT_TRUE(Transform3DFilter::TransformBounds(&bounds, layer, 0));
+  EXPECT_FLOAT_EQ(bounds.left, 50);
+  EXPECT_FLOAT_EQ(bounds.top, 25);
+  EXPECT_FLOAT_EQ(bounds.right, 150);
+  EXPECT_FLOAT_EQ(bounds.bottom, 75);
+
+  // 摄像机的父级带有缩放时，摄像机在合成中的位置和朝向也一并被缩放。
+  auto parent = new NullLayer();
+  parent->containingComposition = composition.get();
+  parent->duration = 1;
+  parent->transform = MakeTransform2D(Point::Zero(), Point::Make(2, 2));
+  composition->layers.push_back(parent);
+  camera->parent = parent;
+  bounds = tgfx::Rect::MakeWH(100, 50);
+  EXPECT_TRUE(Transform3DFilter::TransformBounds(&bounds, layer, 0));
+  EXPECT_FLOAT_EQ(bounds.left, 25);
+  EXPECT_FLOAT_EQ(bounds.top, 12.5f);
+  EXPECT_FLOAT_EQ(bounds.right, 75);
+  EXPECT_FLOAT_EQ(bounds.bottom, 37.5f);
+
+  // 缩放为 0 的父级无法求逆，图层不可见。
+  parent->transform->scale->value = Point::Make(0, 0);
+  bounds = tgfx::Rect::MakeWH(100, 50);
+  EXPECT_FALSE(Transform3DFilter::TransformBounds(&bounds, layer, 0));
+}
+
+static std::shared_ptr<File> Make3DLayerFile(bool hasCamera) {
+  auto composition = new VectorComposition();
+  composition->id = 1;
+  composition->width = 200;
+  composition->height = 100;
+  composition->duration = 1;
+  auto layer = new SolidLayer();
+  layer->id = 2;
+  layer->containingComposition = composition;
+  layer->duration = 1;
+  layer->solidColor = Red;
+  layer->width = 100;
+  layer->height = 50;
+  layer->transform3D = MakeTransform3D(Point3D::Make(50, 25, 0), Point3D::Make(100, 50, 0));
+  layer->transform3D->yRotation->value = 45;
+  composition->layers.push_back(layer);
+  if (hasCamera) {
+    auto zoom = 200.0f * 50.0f / 36.0f;
+    auto camera = MakeCameraLayer(composition, Point3D::Make(40, 20, -zoom),
+                                  Point3D::Make(100, 50, 0), zoom);
+    camera->id = 3;
+    composition->layers.insert(composition->layers.begin(), camera);
+  }
+  composition->updateStaticTimeRanges();
+  composition->staticTimeRangeUpdated = true;
+  return std::shared_ptr<File>(new File({composition}, {}));
+}
+
+/**
+ * 用例描述: 3D 图层分别使用默认摄像机和摄像机图层投影绘制
+ */
+PAG_TEST(PAGFilterTest, Transform3D) {
+  auto pagFile = PAGFile::MakeFrom(Make3DLayerFile(false));
+  ASSERT_TRUE(pagFile != nullptr);
+  auto pagSurface = OffscreenSurface::Make(pagFile->width(), pagFile->height());
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  pagPlayer->flush();
+  EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/Transform3D_DefaultCamera"));
+
+  pagFile = PAGFile::MakeFrom(Make3DLayerFile(true));
+  ASSERT_TRUE(pagFile != nullptr);
+  pagPlayer->setComposition(pagFile);
+  pagPlayer->flush();
+  EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGFilterTest/Transform3D_CameraLayer"));
+}
+
+static std::shared_ptr<PAGLayer> FindTrackMatteLayer(std::shared_ptr<PAGLayer> pagLayer) {
+  if (pagLayer->trackMatteLayer() != nullptr) {
+    return pagLayer->trackMatteLayer();
+  }
+  if (pagLayer->layerType() != LayerType::PreCompose) {
+    return nullptr;
+  }
+  auto composition = std::static_pointer_cast<PAGComposition>(pagLayer);
+  for (int i = 0; i < composition->numChildren(); i++) {
+    auto matteLayer = FindTrackMatteLayer(composition->getLayerAt(i));
+    if (matteLayer != nullptr) {
+      return matteLayer;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * 用例描述: 预热滤镜时包含遮罩图层的滤镜
+ */
+PAG_TEST(PAGFilterTest, WarmUpTrackMatte) {
+  auto pagFile = LoadPAGFile("resources/apitest/AlphaTrackMatte.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto matteLayer = FindTrackMatteLayer(pagFile);
+  ASSERT_NE(matteLayer, nullptr);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setComposition(pagFile);
+  auto pagSurface = OffscreenSurface::Make(pagFile->width(), pagFile->height());
+  ASSERT_NE(pagSurface, nullptr);
+  pagPlayer->setSurface(pagSurface);
+  auto count = pagPlayer->warmUp();
+  auto layer = matteLayer->layer;
+  ASSERT_FALSE(layer->motionBlur);
+  ASSERT_EQ(layer->transform3D, nullptr);
+  // 遮罩图层的运动模糊滤镜也会被预热。
+  layer->motionBlur = true;
+  EXPECT_EQ(pagPlayer->warmUp(), count + 1);
+  layer->motionBlur = false;
+}
 }  // namespace pag
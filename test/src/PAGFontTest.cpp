@@ -20,6 +20,7 @@
 #include <vector>
 #include "base/utils/TimeUtil.h"
 #include "nlohmann/json.hpp"
+#include "rendering/FontManager.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -58,4 +59,59 @@ PAG_TEST(PAGFontTest, TestFont) {
   EXPECT_EQ(errorMsg, "") << "test_font frame fail";
 }
 
+/**
+ * 用例描述: fallback 字体按字符缓存命中结果
+ */
+PAG_TEST(PAGFontTest, FallbackTypeface) {
+  tgfx::GlyphID glyphID = 0;
+  auto typeface = FontManager::GetFallbackTypeface("中", &glyphID);
+  ASSERT_NE(typeface, nullptr);
+  EXPECT_NE(glyphID, 0);
+  tgfx::GlyphID cachedGlyphID = 0;
+  EXPECT_EQ(FontManager::GetFallbackTypeface("中", &cachedGlyphID), typeface);
+  EXPECT_EQ(cachedGlyphID, glyphID);
+  // U+0378 是未分配的码位，没有字体包含它，重复查询也应返回空。
+  auto missing = std::string("\xCD\xB8");
+  EXPECT_EQ(FontManager::GetFallbackTypeface(missing, &glyphID), nullptr);
+  EXPECT_EQ(glyphID, 0);
+  EXPECT_EQ(FontManager::GetFallbackTypeface(missing, &glyphID), nullptr);
+}
+
+/**
+ * 用例描述: 系统字体的查询结果在注册字体或者修改 fallback 字体后清空，并且数量有上限
+ */
+PAG_TEST(PAGFontTest, SystemFontCache) {
+  FontManager manager = {};
+  EXPECT_EQ(manager.getTypefaceWithoutFallback("PAGNotExistFont", "Regular"), nullptr);
+  EXPECT_EQ(manager.systemFontMap.size(), 1u);
+  auto font = manager.registerFont(ProjectPath::Absolute("resources/font/NotoSerifSC-Regular.otf"),
+                                   0, "PAGNotExistFont", "Regular");
+  EXPECT_EQ(font.fontFamily, "PAGNotExistFont");
+  EXPECT_TRUE(manager.systemFontMap.empty());
+  EXPECT_NE(manager.getTypefaceWithoutFallback("PAGNotExistFont", "Regular"), nullptr);
+
+  EXPECT_EQ(manager.getTypefaceWithoutFallback("PAGNotExistFont", "Bold"), nullptr);
+  EXPECT_EQ(manager.systemFontMap.size(), 1u);
+  manager.setFallbackFontNames({});
+  EXPECT_TRUE(manager.systemFontMap.empty());
+
+  for (size_t i = 0; i <= FontManager::MaxSystemFontCount; i++) {
+    manager.getTypefaceWithoutFallback("PAGNotExistFont" + std::to_string(i), "Regular");
+    EXPECT_LE(manager.systemFontMap.size(), FontManager::MaxSystemFontCount);
+  }
+}
+
+/**
+ * 用例描述: 字符命中的 fallback 字体缓存数量有上限
+ */
+PAG_TEST(PAGFontTest, FallbackGlyphCache) {
+  FontManager manager = {};
+  tgfx::GlyphID glyphID = 0;
+  for (size_t i = 0; i <= FontManager::MaxFallbackGlyphCount; i++) {
+    manager.getFallbackTypeface(std::to_string(i), &glyphID);
+    EXPECT_LE(manager.fallbackGlyphMap.size(), FontManager::MaxFallbackGlyphCount);
+  }
+  EXPECT_EQ(manager.fallbackGlyphMap.size(), 1u);
+}
+
 }  // namespace pag
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <filesystem>
+#include "rendering/graphics/GradientPaint.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -37,4 +38,49 @@ PAG_TEST(PAGGradientColorTest, GradientColor) {
     EXPECT_TRUE(Baseline::Compare(TestPAGSurface, "PAGGradientColorTest/" + key.string()));
   }
 }
+
+/**
+ * 用例描述: 相同的渐变值复用合并后的色标
+ */
+PAG_TEST(PAGGradientColorTest, GradientRamp) {
+  auto gradientColor = std::make_shared<GradientColor>();
+  gradientColor->colorStops.push_back({0.0f, 0.3f, Red});
+  gradientColor->colorStops.push_back({1.0f, 0.5f, Blue});
+  gradientColor->alphaStops.push_back({0.0f, 0.5f, Opaque});
+  gradientColor->alphaStops.push_back({0.5f, 0.5f, Transparent});
+  auto matrix = tgfx::Matrix::I();
+  GradientPaint paint(GradientFillType::Linear, Point::Zero(), Point::Make(100, 0), gradientColor,
+                      matrix);
+  GradientPaint nextPaint(GradientFillType::Linear, Point::Make(10, 10), Point::Make(50, 50),
+                          gradientColor, matrix);
+  ASSERT_NE(paint.ramp, nullptr);
+  EXPECT_EQ(paint.ramp, nextPaint.ramp);
+  EXPECT_EQ(paint.ramp->colors.size(), paint.ramp->positions.size());
+  EXPECT_EQ(paint.ramp->positions.size(), 4u);
+  GradientPaint reversedPaint(GradientFillType::Linear, Point::Zero(), Point::Make(100, 0),
+                              gradientColor, matrix, true);
+  EXPECT_NE(paint.ramp, reversedPaint.ramp);
+  EXPECT_EQ(reversedPaint.ramp->positions.front(), 0.0f);
+  EXPECT_NE(paint.getShader(), nullptr);
+
+  // 动画渐变每帧会插值出新的对象，数值相同时仍然复用同一份色标。
+  auto sameGradientColor = std::make_shared<GradientColor>(*gradientColor);
+  GradientPaint samePaint(GradientFillType::Radial, Point::Zero(), Point::Make(100, 0),
+                          sameGradientColor, matrix);
+  EXPECT_EQ(samePaint.ramp, paint.ramp);
+
+  // 缓存数量有上限，最早使用的色标会被淘汰后重新生成。
+  auto makeAnimatedPaint = [&](int index) {
+    auto animatedColor = std::make_shared<GradientColor>(*gradientColor);
+    animatedColor->colorStops[1].position = static_cast<float>(index) / 1000.0f;
+    return GradientPaint(GradientFillType::Linear, Point::Zero(), Point::Make(100, 0),
+                         animatedColor, matrix);
+  };
+  auto firstRamp = makeAnimatedPaint(0).ramp;
+  EXPECT_EQ(makeAnimatedPaint(0).ramp, firstRamp);
+  for (int i = 1; i < 1000; i++) {
+    EXPECT_NE(makeAnimatedPaint(i).ramp, nullptr);
+  }
+  EXPECT_NE(makeAnimatedPaint(0).ramp, firstRamp);
+}
 }  // namespace pag
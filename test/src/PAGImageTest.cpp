@@ -17,8 +17,12 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <thread>
+#include "base/utils/UniqueID.h"
 #include "nlohmann/json.hpp"
 #include "pag/pag.h"
+#include "rendering/caches/ImageBytesCache.h"
+#include "rendering/caches/RenderCache.h"
+#include "rendering/graphics/CodecImageProxy.h"
 #include "tgfx/core/ImageCodec.h"
 #include "tgfx/core/Surface.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
@@ -142,7 +146,7 @@ PAG_TEST(PAGImageTest, image3) {
 PAG_TEST(PAGImageTest, BottomLeftMask) {
   int width = 110;
   int height = 110;
-  auto device = DevicePool::Make();
+  auto device = GLDevicePool::Lease();
   auto context = device->lockContext();
   ASSERT_TRUE(context != nullptr);
   auto surface = Surface::Make(context, width, height);
@@ -164,4 +168,75 @@ PAG_TEST(PAGImageTest, BottomLeftMask) {
   device->unlock();
   EXPECT_TRUE(Baseline::Compare(pixmap, "PAGImageTest/BottomLeftMask"));
 }
+
+/**
+ * 用例描述: 显示尺寸较小时按缩小后的尺寸解码图片，上传到 GPU 后释放内存中的解码结果
+ */
+PAG_TEST(PAGImageTest, CodecImageProxy) {
+  PAG_SETUP(TestPAGSurface, TestPAGPlayer, TestPAGFile);
+  auto codec = MakeImageCodec("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(codec != nullptr);
+  auto image = MakeImage("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(image != nullptr);
+  auto proxy = std::make_shared<CodecImageProxy>(UniqueID::Next(), codec, image);
+  auto cache = TestPAGPlayer->renderCache;
+  // 还没有缩小的解码结果时不在渲染线程解码，先使用原图，同时在后台按 1/4 解码（0.2 向上取整）。
+  EXPECT_EQ(proxy->getScaledImage(cache, 0.2f)->width(), 110);
+  EXPECT_TRUE(proxy->pendingImage != nullptr);
+  auto scaledImage = proxy->getScaledImage(cache, 0.2f);
+  ASSERT_TRUE(scaledImage != nullptr);
+  EXPECT_EQ(scaledImage->width(), 28);
+  EXPECT_EQ(scaledImage->height(), 28);
+  // 更小的显示比例复用已有的解码结果。
+  EXPECT_EQ(proxy->getScaledImage(cache, 0.1f), scaledImage);
+  // 显示比例变大时同样先使用原图，后台按更大的尺寸解码完成后再替换。
+  EXPECT_EQ(proxy->getScaledImage(cache, 0.4f)->width(), 110);
+  auto largerImage = proxy->getScaledImage(cache, 0.4f);
+  ASSERT_TRUE(largerImage != nullptr);
+  EXPECT_EQ(largerImage->width(), 55);
+  EXPECT_EQ(largerImage->height(), 55);
+  // 显示比例超过一半时直接使用原图。
+  EXPECT_EQ(proxy->getScaledImage(cache, 0.8f)->width(), 110);
+  proxy->releaseScaledImage();
+  EXPECT_TRUE(proxy->scaledImage == nullptr);
+}
+
+/**
+ * 用例描述: 内嵌图片解码时共享 ImageBytes 的文件数据，不拷贝也不替换 fileBytes
+ */
+PAG_TEST(PAGImageTest, SharedImageBytes) {
+  auto file = File::Load(ProjectPath::Absolute("resources/apitest/replace2.pag"));
+  ASSERT_TRUE(file != nullptr);
+  ASSERT_FALSE(file->images.empty());
+  auto imageBytes = file->images[0];
+  auto fileBytes = imageBytes->fileBytes;
+  ASSERT_TRUE(fileBytes != nullptr);
+  ASSERT_TRUE(imageBytes->sharedBytes != nullptr);
+  EXPECT_EQ(imageBytes->sharedBytes->data(), fileBytes->data());
+  std::weak_ptr<ByteData> sharedBytes = imageBytes->sharedBytes;
+  auto useCount = sharedBytes.use_count();
+  auto graphic = ImageBytesCache::Get(imageBytes)->graphic;
+  ASSERT_TRUE(graphic != nullptr);
+  // fileBytes 不会被替换，其他线程可以不加锁读取。
+  EXPECT_EQ(imageBytes->fileBytes, fileBytes);
+  // 解码器借用同一份数据。
+  EXPECT_EQ(sharedBytes.use_count(), useCount + 1);
+  // File 释放后图片仍持有数据，图片释放后数据随之释放。
+  file = nullptr;
+  EXPECT_FALSE(sharedBytes.expired());
+  graphic = nullptr;
+  EXPECT_TRUE(sharedBytes.expired());
+
+  // 用户替换过的 fileBytes 没有共享的持有者，解码器使用拷贝的数据。
+  file = File::Load(ProjectPath::Absolute("resources/apitest/replace2.pag"));
+  ASSERT_TRUE(file != nullptr);
+  imageBytes = file->images[0];
+  fileBytes = imageBytes->fileBytes;
+  imageBytes->fileBytes = ByteData::MakeCopy(fileBytes->data(), fileBytes->length()).release();
+  delete fileBytes;
+  sharedBytes = imageBytes->sharedBytes;
+  useCount = sharedBytes.use_count();
+  EXPECT_TRUE(ImageBytesCache::Get(imageBytes)->graphic != nullptr);
+  EXPECT_EQ(sharedBytes.use_count(), useCount);
+}
 }  // namespace pag
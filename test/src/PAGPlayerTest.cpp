@@ -16,7 +16,13 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "base/utils/UniqueID.h"
 #include "nlohmann/json.hpp"
+#include "rendering/caches/RenderCache.h"
+#include "rendering/graphics/Picture.h"
+#include "rendering/graphics/Shape.h"
+#include "rendering/graphics/Snapshot.h"
+#include "rendering/layers/PAGStage.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -129,4 +135,138 @@ PAG_TEST(PAGPlayerTest, autoClear) {
   EXPECT_TRUE(Baseline::Compare(pagSurface, "PAGPlayerTest/autoClear_autoClear_true"));
 }
 
-}  // namespace pag
\ No newline at end of file
+/**
+ * 用例描述: 显存预测会影响快照缓存的清理时机
+ */
+PAG_TEST(PAGPlayerTest, MemoryForecastEviction) {
+  PAG_SETUP(TestPAGSurface, TestPAGPlayer, TestPAGFile);
+  TestPAGPlayer->flush();
+  // 与 RenderCache 中的 PURGEABLE_GRAPHICS_MEMORY 一致。
+  int64_t purgeableMemory = 20971520;
+  auto renderCache = TestPAGPlayer->renderCache;
+  renderCache->clearAllSnapshots();
+  renderCache->usedAssets.clear();
+  Bitmap bitmap(256, 256, false, false);
+  auto image = tgfx::Image::MakeFrom(bitmap);
+  ASSERT_TRUE(image != nullptr);
+  auto addSnapshot = [&]() {
+    auto snapshot = new Snapshot(image, tgfx::Matrix::I());
+    snapshot->assetID = UniqueID::Next();
+    renderCache->graphicsMemory += snapshot->memoryUsage();
+    renderCache->snapshotLRU.push_front(snapshot);
+    renderCache->snapshotPositions[snapshot] = renderCache->snapshotLRU.begin();
+    renderCache->snapshotCaches[snapshot->assetID] = snapshot;
+    return snapshot->assetID;
+  };
+
+  // 没有显存增长时，未超过上限的快照会被保留。
+  auto assetID = addSnapshot();
+  renderCache->currentForecastMemory = 0;
+  renderCache->upcomingForecastMemory = 0;
+  renderCache->clearExpiredSnapshots();
+  EXPECT_EQ(renderCache->snapshotCaches.count(assetID), 1u);
+
+  // 即将到来的显存峰值会提前清理空闲的快照。
+  renderCache->upcomingForecastMemory = purgeableMemory;
+  renderCache->clearExpiredSnapshots();
+  EXPECT_EQ(renderCache->snapshotCaches.count(assetID), 0u);
+
+  // 当前帧本身就需要的显存不会被当作冗余缓存清理。
+  assetID = addSnapshot();
+  auto extraMemory = static_cast<size_t>(purgeableMemory);
+  renderCache->graphicsMemory += extraMemory;
+  renderCache->currentForecastMemory = purgeableMemory * 2;
+  renderCache->upcomingForecastMemory = purgeableMemory * 2;
+  renderCache->clearExpiredSnapshots();
+  EXPECT_EQ(renderCache->snapshotCaches.count(assetID), 1u);
+  renderCache->currentForecastMemory = 0;
+  renderCache->upcomingForecastMemory = 0;
+  renderCache->clearExpiredSnapshots();
+  EXPECT_EQ(renderCache->snapshotCaches.count(assetID), 0u);
+  renderCache->graphicsMemory -= extraMemory;
+}
+
+/**
+ * 用例描述: 滤镜质量随渲染耗时逐步降低和恢复，质量变化后只有由滤镜渲染的内容快照和录制结果失效
+ */
+PAG_TEST(PAGPlayerTest, AdaptiveQuality) {
+  PAG_SETUP(TestPAGSurface, TestPAGPlayer, TestPAGFile);
+  TestPAGPlayer->flush();
+  auto renderCache = TestPAGPlayer->renderCache;
+  renderCache->clearAllSnapshots();
+  Bitmap bitmap(64, 64, false, false);
+  auto image = tgfx::Image::MakeFrom(bitmap);
+  ASSERT_TRUE(image != nullptr);
+  auto imagePicture = Picture::MakeFrom(UniqueID::Next(), image);
+  tgfx::Path path = {};
+  path.addRect(tgfx::Rect::MakeWH(64, 64));
+  auto shape = Shape::MakeFrom(0, path, tgfx::Color::Black());
+  auto shapePicture = Picture::MakeFrom(UniqueID::Next(), shape);
+  auto filterPicture = Picture::MakeFrom(UniqueID::Next(), shape, true);
+  ASSERT_TRUE(imagePicture != nullptr && shapePicture != nullptr && filterPicture != nullptr);
+  auto addSnapshot = [&](Picture* picture) {
+    auto snapshot = new Snapshot(image, tgfx::Matrix::I());
+    snapshot->assetID = picture->assetID;
+    snapshot->makerKey = picture->uniqueKey;
+    snapshot->qualityVersion =
+        picture->dependsOnFilterQuality() ? renderCache->filterQualityVersion : 0;
+    renderCache->graphicsMemory += snapshot->memoryUsage();
+    renderCache->snapshotLRU.push_front(snapshot);
+    renderCache->snapshotPositions[snapshot] = renderCache->snapshotLRU.begin();
+    renderCache->snapshotCaches[snapshot->assetID] = snapshot;
+    renderCache->stage->scaleFactorCache[snapshot->assetID] = {1.0f, 1.0f};
+    return snapshot;
+  };
+  auto imageSnapshot = addSnapshot(static_cast<Picture*>(imagePicture.get()));
+  auto shapeSnapshot = addSnapshot(static_cast<Picture*>(shapePicture.get()));
+  auto filterSnapshot = addSnapshot(static_cast<Picture*>(filterPicture.get()));
+  EXPECT_EQ(renderCache->getSnapshot(static_cast<Picture*>(filterPicture.get())),
+            filterSnapshot);
+  auto stage = renderCache->stage;
+  auto shapeID = UniqueID::Next();
+  auto filterID = UniqueID::Next();
+  stage->retainedGraphics[shapeID] = {shape, false, false};
+  stage->retainedGraphics[filterID] = {shape, false, true};
+
+  renderCache->setAdaptiveQuality(true);
+  auto version = renderCache->filterQualityVersion;
+  // 超过帧间隔立即降低质量，最低降到 0.25。
+  renderCache->updateFilterQuality(20000, 16666);
+  EXPECT_FLOAT_EQ(renderCache->filterQuality.level, 0.75f);
+  EXPECT_EQ(renderCache->filterQualityVersion, version + 1);
+  for (int i = 0; i < 10; i++) {
+    renderCache->updateFilterQuality(20000, 16666);
+  }
+  EXPECT_FLOAT_EQ(renderCache->filterQuality.level, 0.25f);
+  version = renderCache->filterQualityVersion;
+
+  // 图片和普通矢量内容的快照与滤镜质量无关，继续复用；由滤镜渲染的内容快照需要重新生成。
+  EXPECT_EQ(renderCache->getSnapshot(static_cast<Picture*>(imagePicture.get())), imageSnapshot);
+  EXPECT_EQ(renderCache->getSnapshot(static_cast<Picture*>(shapePicture.get())), shapeSnapshot);
+  auto filterAssetID = filterSnapshot->assetID;
+  renderCache->getSnapshot(static_cast<Picture*>(filterPicture.get()));
+  EXPECT_EQ(renderCache->snapshotCaches.count(filterAssetID), 0u);
+  // 只有带滤镜的录制结果需要重新录制。
+  EXPECT_EQ(stage->retainedGraphics.count(shapeID), 1u);
+  EXPECT_EQ(stage->retainedGraphics.count(filterID), 0u);
+  stage->retainedGraphics.erase(shapeID);
+
+  // 连续 30 帧有富余才提升一档质量，中途出现没有富余的帧会重新计数。
+  for (int i = 0; i < 29; i++) {
+    renderCache->updateFilterQuality(5000, 16666);
+  }
+  renderCache->updateFilterQuality(10000, 16666);
+  for (int i = 0; i < 29; i++) {
+    renderCache->updateFilterQuality(5000, 16666);
+  }
+  EXPECT_FLOAT_EQ(renderCache->filterQuality.level, 0.25f);
+  EXPECT_EQ(renderCache->filterQualityVersion, version);
+  renderCache->updateFilterQuality(5000, 16666);
+  EXPECT_FLOAT_EQ(renderCache->filterQuality.level, 0.375f);
+  EXPECT_EQ(renderCache->filterQualityVersion, version + 1);
+
+  renderCache->setAdaptiveQuality(false);
+  EXPECT_FLOAT_EQ(renderCache->filterQuality.level, 1.0f);
+  renderCache->clearAllSnapshots();
+}
+}  // namespace pag
@@ -20,6 +20,8 @@
 #include "pag/pag.h"
 #include "platform/swiftshader/NativePlatform.h"
 #include "rendering/caches/RenderCache.h"
+#include "rendering/sequences/VideoReader.h"
+#include "rendering/video/VideoDecoderPool.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -151,4 +153,139 @@ PAG_TEST(PAGSequenceTest, Sequence_Multiple_References) {
   EXPECT_EQ(static_cast<int>(sequenceCaches.begin()->second.size()), 1);
 }
 
+class PooledTestDecoder : public VideoDecoder {
+ public:
+  int flushCount = 0;
+
+  DecodingResult onSendBytes(void*, size_t, int64_t) override {
+    return DecodingResult::Success;
+  }
+
+  DecodingResult onEndOfStream() override {
+    return DecodingResult::Success;
+  }
+
+  DecodingResult onDecodeFrame() override {
+    return DecodingResult::Success;
+  }
+
+  void onFlush() override {
+    flushCount++;
+  }
+
+  std::shared_ptr<tgfx::ImageBuffer> onRenderFrame() override {
+    return nullptr;
+  }
+
+  int64_t presentationTime() override {
+    return 0;
+  }
+};
+
+class PooledTestDecoderFactory : public VideoDecoderFactory {
+ public:
+  bool isHardwareBacked() const override {
+    return false;
+  }
+
+ protected:
+  std::unique_ptr<VideoDecoder> onCreateDecoder(const VideoFormat&) const override {
+    return std::make_unique<PooledTestDecoder>();
+  }
+};
+
+/**
+ * 用例描述: 空闲的视频解码器按视频格式复用
+ */
+PAG_TEST(PAGSequenceTest, VideoDecoderPool) {
+  PooledTestDecoderFactory factory = {};
+  VideoFormat format = {};
+  format.width = 720;
+  format.height = 1280;
+  uint8_t header[] = {0, 0, 0, 1, 103, 100};
+  format.headers.push_back(tgfx::Data::MakeWithCopy(header, sizeof(header)));
+  auto decoder = factory.createDecoder(format);
+  ASSERT_NE(decoder, nullptr);
+  auto decoderPtr = decoder.get();
+  VideoDecoderPool::Recycle(&factory, format, std::move(decoder));
+
+  auto otherFormat = format;
+  otherFormat.height = 720;
+  EXPECT_EQ(VideoDecoderPool::Obtain(&factory, otherFormat), nullptr);
+  auto pooledDecoder = VideoDecoderPool::Obtain(&factory, format);
+  ASSERT_EQ(pooledDecoder.get(), decoderPtr);
+  EXPECT_EQ(static_cast<PooledTestDecoder*>(pooledDecoder.get())->flushCount, 1);
+  EXPECT_EQ(VideoDecoderPool::Obtain(&factory, format), nullptr);
+
+  PAGVideoDecoder::SetMaxIdleDecoderCount(0);
+  VideoDecoderPool::Recycle(&factory, format, std::move(pooledDecoder));
+  EXPECT_EQ(VideoDecoderPool::Obtain(&factory, format), nullptr);
+  PAGVideoDecoder::SetMaxIdleDecoderCount(4);
+}
+
+/**
+ * 用例描述: 注册新的软件解码器工厂时，销毁旧工厂创建的空闲解码器
+ */
+PAG_TEST(PAGSequenceTest, VideoDecoderPoolClear) {
+  PooledTestDecoderFactory factory = {};
+  VideoFormat format = {};
+  format.width = 720;
+  format.height = 1280;
+  auto externalFactory = VideoDecoderFactory::ExternalDecoderFactory();
+  VideoDecoderPool::Recycle(externalFactory, format, factory.createDecoder(format));
+  VideoDecoderPool::Recycle(&factory, format, factory.createDecoder(format));
+  PAGVideoDecoder::RegisterSoftwareDecoderFactory(nullptr);
+  EXPECT_EQ(VideoDecoderPool::Obtain(externalFactory, format), nullptr);
+  // 其他工厂创建的解码器不受影响。
+  EXPECT_NE(VideoDecoderPool::Obtain(&factory, format), nullptr);
+}
+/**
+ * 用例描述: 向后 seek 时缓存关键帧到目标帧之间的帧
+ */
+PAG_TEST(PAGSequenceTest, ReverseFrameCache) {
+  PAGVideoDecoder::SetMaxReverseCacheSize(64 * 1024 * 1024);
+  auto pagFile = LoadPAGFile("resources/apitest/wz_mvp.pag");
+  ASSERT_NE(pagFile, nullptr);
+  auto pagSurface = OffscreenSurface::Make(750, 1334);
+  auto pagPlayer = std::make_shared<PAGPlayer>();
+  pagPlayer->setSurface(pagSurface);
+  pagPlayer->setComposition(pagFile);
+  pagPlayer->setProgress(0.5);
+  pagPlayer->flush();
+  pagPlayer->preFrame();
+  pagPlayer->flush();
+  auto& sequenceCaches = pagPlayer->renderCache->sequenceCaches;
+  ASSERT_EQ(static_cast<int>(sequenceCaches.size()), 1);
+  auto reader = static_cast<VideoReader*>(sequenceCaches.begin()->second.front()->reader.get());
+  EXPECT_FALSE(reader->reverseFrames.empty());
+  auto cachedFrames = reader->reverseFrames.size();
+  pagPlayer->preFrame();
+  pagPlayer->flush();
+  EXPECT_GE(reader->reverseFrames.size(), cachedFrames);
+  // 缓存按实际拷贝的字节数（包含行对齐的填充）计算。
+  size_t cachedBytes = 0;
+  for (auto& item : reader->reverseFrames) {
+    EXPECT_GE(item.second.byteSize,
+              static_cast<size_t>(reader->width()) * reader->height() * 3 / 2);
+    cachedBytes += item.second.byteSize;
+  }
+  EXPECT_EQ(reader->reverseCacheBytes, cachedBytes);
+  auto frameBytes = reader->reverseFrames.begin()->second.byteSize;
+  PAGVideoDecoder::SetMaxReverseCacheSize(frameBytes);
+  EXPECT_EQ(reader->reverseFrames.size(), 1u);
+  EXPECT_EQ(reader->reverseCacheBytes, frameBytes);
+  PAGVideoDecoder::SetMaxReverseCacheSize(0);
+  EXPECT_TRUE(reader->reverseFrames.empty());
+  EXPECT_EQ(reader->reverseCacheBytes, 0u);
+
+  // 解码器被销毁或者替换后，旧的缓存帧也一起清空。
+  PAGVideoDecoder::SetMaxReverseCacheSize(64 * 1024 * 1024);
+  pagPlayer->preFrame();
+  pagPlayer->flush();
+  EXPECT_FALSE(reader->reverseFrames.empty());
+  reader->destroyVideoDecoder();
+  EXPECT_TRUE(reader->reverseFrames.empty());
+  EXPECT_EQ(reader->reverseCacheBytes, 0u);
+  PAGVideoDecoder::SetMaxReverseCacheSize(0);
+}
 }  // namespace pag
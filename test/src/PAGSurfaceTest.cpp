@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "rendering/drawables/TextureDrawable.h"
+#include "rendering/utils/GLDevicePool.h"
+#include "tgfx/core/Surface.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 #include "tgfx/gpu/opengl/GLFunctions.h"
 #include "utils/TestUtils.h"
@@ -64,7 +66,7 @@ PAG_TEST(PAGSurfaceTest, FromTexture) {
   auto pagFile = LoadPAGFile("resources/apitest/test.pag");
   int width = pagFile->width();
   int height = pagFile->height();
-  auto device = DevicePool::Make();
+  auto device = GLDevicePool::Lease();
   ASSERT_TRUE(device != nullptr);
   auto context = device->lockContext();
   ASSERT_TRUE(context != nullptr);
@@ -121,7 +123,7 @@ PAG_TEST(PAGSurfaceTest, Mask) {
   auto pagFile = LoadPAGFile("assets/test2.pag");
   auto width = pagFile->width();
   auto height = pagFile->height();
-  auto device = DevicePool::Make();
+  auto device = GLDevicePool::Lease();
   ASSERT_TRUE(device != nullptr);
   auto context = device->lockContext();
   ASSERT_TRUE(context != nullptr);
@@ -153,7 +155,7 @@ PAG_TEST(PAGSurfaceTest, BottomLeftScissor) {
   auto pagFile = LoadPAGFile("assets/test.pag");
   auto width = pagFile->width();
   auto height = pagFile->height() * 2;
-  auto device = DevicePool::Make();
+  auto device = GLDevicePool::Lease();
   auto context = device->lockContext();
   ASSERT_TRUE(context != nullptr);
   tgfx::GLTextureInfo textureInfo;
@@ -176,4 +178,47 @@ PAG_TEST(PAGSurfaceTest, BottomLeftScissor) {
   gl->deleteTextures(1, &textureInfo.id);
   device->unlock();
 }
+
+/**
+ * 用例描述: GLDevicePool 在设备繁忙时创建新设备，租约结束后只保留一个空闲设备
+ */
+PAG_TEST(PAGSurfaceTest, GLDevicePool) {
+  auto device = GLDevicePool::Lease();
+  ASSERT_TRUE(device != nullptr);
+  auto busyDevice = GLDevicePool::Lease();
+  ASSERT_TRUE(busyDevice != nullptr);
+  EXPECT_NE(device.get(), busyDevice.get());
+  // 复制租约不会增加设备的租约数。
+  auto sharedDevice = busyDevice;
+  auto countLeases = [](tgfx::GLDevice* target) {
+    std::lock_guard<std::mutex> autoLock(GLDevicePool::locker);
+    for (auto& item : *GLDevicePool::devices) {
+      if (item.device.get() == target) {
+        return item.leases;
+      }
+    }
+    return -1;
+  };
+  EXPECT_EQ(countLeases(busyDevice.get()), 1);
+  auto context = busyDevice->lockContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = tgfx::Surface::Make(context, 100, 100);
+  EXPECT_TRUE(surface != nullptr);
+  surface = nullptr;
+  busyDevice->unlock();
+
+  auto numDevices = GLDevicePool::devices->size();
+  device = nullptr;
+  busyDevice = nullptr;
+  EXPECT_EQ(countLeases(sharedDevice.get()), 1);
+  sharedDevice = nullptr;
+  size_t idleDevices = 0;
+  for (auto& item : *GLDevicePool::devices) {
+    if (item.leases == 0) {
+      idleDevices++;
+    }
+  }
+  EXPECT_EQ(idleDevices, 1u);
+  EXPECT_EQ(GLDevicePool::devices->size(), numDevices - 1);
+}
 }  // namespace pag
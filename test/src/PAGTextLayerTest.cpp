@@ -23,6 +23,7 @@
 #include "nlohmann/json.hpp"
 #include "pag/file.h"
 #include "rendering/renderers/TextRenderer.h"
+#include "rendering/renderers/TextSelectorRenderer.h"
 #include "utils/TestUtils.h"
 
 namespace pag {
@@ -539,4 +540,73 @@ PAG_TEST(PAGTextLayerTest, TextLayerScaleAnimationWithMipmap) {
   EXPECT_TRUE(
       Baseline::Compare(TestPAGSurface, "PAGTextLayerTest/TextLayerScaleAnimationWithMipmap"));
 }
+
+static TextRangeSelector* MakeRangeSelector(Enum shape, Enum mode, bool randomizeOrder) {
+  auto selector = new TextRangeSelector();
+  selector->start = new Property<Percent>(0.1f);
+  selector->end = new Property<Percent>(0.8f);
+  selector->offset = new Property<float>(0.05f);
+  selector->mode = new Property<Enum>(mode);
+  selector->amount = new Property<Percent>(0.9f);
+  selector->shape = shape;
+  selector->smoothness = new Property<Percent>(1.0f);
+  selector->easeHigh = new Property<Percent>(0.3f);
+  selector->easeLow = new Property<Percent>(-0.2f);
+  selector->randomizeOrder = randomizeOrder;
+  selector->randomSeed = new Property<uint16_t>(7);
+  return selector;
+}
+
+static TextWigglySelector* MakeWigglySelector(Enum mode) {
+  auto selector = new TextWigglySelector();
+  selector->mode = new Property<Enum>(mode);
+  selector->maxAmount = new Property<Percent>(0.8f);
+  selector->minAmount = new Property<Percent>(-0.6f);
+  selector->wigglesPerSecond = new Property<float>(2.5f);
+  selector->correlation = new Property<Percent>(0.3f);
+  selector->temporalPhase = new Property<float>(45.0f);
+  selector->spatialPhase = new Property<float>(90.0f);
+  selector->lockDimensions = new Property<bool>(false);
+  selector->randomSeed = new Property<uint16_t>(3);
+  return selector;
+}
+
+/**
+ * 用例描述: 批量计算范围因子的结果需要与逐个字符计算的结果一致
+ */
+PAG_TEST(PAGTextLayerTest, CalculateFactorsFromSelectors) {
+  std::vector<Enum> shapes = {TextRangeSelectorShape::Square,   TextRangeSelectorShape::RampUp,
+                              TextRangeSelectorShape::RampDown, TextRangeSelectorShape::Triangle,
+                              TextRangeSelectorShape::Round,    TextRangeSelectorShape::Smooth};
+  std::vector<Enum> modes = {TextSelectorMode::Add,        TextSelectorMode::Subtract,
+                             TextSelectorMode::Intersect,  TextSelectorMode::Min,
+                             TextSelectorMode::Max,        TextSelectorMode::Difference};
+  size_t textCount = 13;
+  Frame frame = 12;
+  for (auto shape : shapes) {
+    for (auto mode : modes) {
+      for (auto randomizeOrder : {false, true}) {
+        std::unique_ptr<TextRangeSelector> rangeSelector(
+            MakeRangeSelector(shape, mode, randomizeOrder));
+        std::unique_ptr<TextWigglySelector> wigglySelector(MakeWigglySelector(mode));
+        RangeSelectorRenderer rangeRenderer(rangeSelector.get(), textCount, frame);
+        WigglySelectorRenderer wigglyRenderer(wigglySelector.get(), textCount, frame);
+        std::vector<std::vector<TextSelectorRenderer*>> selectorGroups = {
+            {&rangeRenderer}, {&wigglyRenderer}, {&rangeRenderer, &wigglyRenderer}};
+        for (auto& selectorRenderers : selectorGroups) {
+          std::vector<float> factors;
+          TextSelectorRenderer::CalculateFactorsFromSelectors(selectorRenderers, textCount,
+                                                              &factors);
+          ASSERT_EQ(factors.size(), textCount);
+          for (size_t i = 0; i < textCount; i++) {
+            auto factor = TextSelectorRenderer::CalculateFactorFromSelectors(selectorRenderers, i);
+            EXPECT_FLOAT_EQ(factors[i], factor)
+                << "shape:" << static_cast<int>(shape) << " mode:" << static_cast<int>(mode)
+                << " index:" << i;
+          }
+        }
+      }
+    }
+  }
+}
 }  // namespace pag
@@ -21,7 +21,7 @@
 
 namespace pag {
 std::shared_ptr<PAGSurface> OffscreenSurface::Make(int width, int height) {
-  auto device = DevicePool::Make();
+  auto device = GLDevicePool::Lease();
   if (device == nullptr || width <= 0 || height <= 0) {
     return nullptr;
   }
@@ -19,7 +19,7 @@
 #pragma once
 
 #include "pag/pag.h"
-#include "utils/DevicePool.h"
+#include "rendering/utils/GLDevicePool.h"
 
 namespace pag {
 class OffscreenSurface {